@@ -0,0 +1,972 @@
+#! /usr/bin/env python3
+# -----------------------------------------------------------------------------
+# Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+# Released under The MIT License (MIT) (see "license.md")
+# Project located at <https://github.com/benblazak/ergodox-firmware>
+# -----------------------------------------------------------------------------
+
+"""
+Generate a layout's source ('.c' and '.h') from a declarative keymap (in JSON)
+
+Depends on:
+- the project source code (for key function names and keycode names)
+- the matrix file (for the physical <-> matrix position mapping)
+
+The keymap is validated before anything is written, so mistakes that would
+otherwise only show up as odd behaviour on the keyboard (a transparent key on
+layer 0, a layer-push to a layer that isn't defined, a misspelled function)
+fail the build instead.
+
+Along with the usual PROGMEM matrices, a per-key flags matrix is generated
+(`_kb_layout_key_flags`) so that the main loop can skip work for keys whose
+mapping is known ahead of time (see "default--matrix-control.h").
+
+Several keymaps may be given, in which case they're linked into one layout,
+selectable at runtime.  Layers that are identical (in any of the keymaps) are
+stored only once, and each keymap gets a table mapping its layer numbers to
+the layers actually stored.
+"""
+
+_FORMAT_DESCRIPTION = ("""
+/* ----------------------------------------------------------------------------
+ * Version 0
+ * ----------------------------------------------------------------------------
+ * Either a UI info file (as generated by 'gen-ui-info.py', in which case only
+ * 'mappings.matrix-layout' is used), or:
+ * ------------------------------------------------------------------------- */
+
+var keymap = {
+    "description": "<string>",     // optional; goes in the file header
+    "order": "<string>",           // optional; "physical" or "matrix"
+                                   //   (default: inferred from the number
+                                   //   of keys per layer, 80 or 84)
+    "leds": {                      // optional; default: as in the other
+        "num": "<number>",         //   layouts (1, 2, 3); 0 for none
+        "caps": "<number>",
+        "scroll": "<number>",
+        "compose": "<number>",
+        "kana": "<number>"
+    },
+    "layers": [
+        [
+            [ "<keycode>", "<press function>", "<release function>" ],
+            "..."
+        ],
+        "..."
+    ],
+    "combos": [                    // optional; keys pressed together, on
+        {                          //   any layer (see
+            "keys": [              //   "default--matrix-control.h")
+                "<key id>",        // e.g. "k35" (see "matrix.h")
+                "..."
+            ],
+            "keycode": "<keycode>"
+        },
+        "..."
+    ],
+    "macros": [                    // optional; for 'kbfun_macro_play' (the
+        [                          //   keycode is the macro's index), and
+            "<keycode>",           //   the leader key
+            { "shifted": "<keycode>" },
+            { "altgr": "<keycode>" },
+            { "down": "<keycode>" },
+            { "up": "<keycode>" },
+            { "delay": "<number>" },  // in reports
+            { "push": "<layer>" },
+            { "pop": null },
+            "..."
+        ],
+        "..."
+    ],
+    "unicode": [                   // optional; for 'kbfun_unicode' (the
+        "<character>",             //   keycode is the character's index)
+        "..."
+    ],
+    "leader": [                    // optional; sequences to type after
+        {                          //   'kbfun_leader'
+            "keys": [ "<keycode>", "..." ],
+            "macro": "<number>"    // the index of the macro to play
+        },
+        "..."
+    ],
+    "tap_holds": [                 // optional; for 'kbfun_tap_hold' (the
+        {                          //   keycode is the entry's index)
+            "tap": "<keycode>",
+            "hold": "<keycode>",   // either a keycode to hold,
+            "layer": "<number>",   //   or a layer to push
+            "flags": [             // optional; "permissive", and/or
+                "<flag>",          //   "on_other_key" (see
+                "..."              //   "default--matrix-control.h")
+            ]
+        },
+        "..."
+    ],
+    "tap_dances": [                // optional; for 'kbfun_tap_dance' (the
+        {                          //   keycode is the entry's index); each
+            "tap": "<keycode>",    //   keycode is optional (default: 0,
+            "double_tap": "<keycode>",  // for nothing; see
+            "triple_tap": "<keycode>",  // "default--matrix-control.h")
+            "hold": "<keycode>",
+            "tap_hold": "<keycode>"
+        },
+        "..."
+    ]
+}
+
+/* ----------------------------------------------------------------------------
+ * - A '<keycode>' may be a number, or the name of a keycode (e.g. "KEY_a_A",
+ *   "_A", "MEDIAKEY_STOP", or "0x35").
+ * - A '<... function>' may be the name of a key function, with or without the
+ *   'kbfun_' prefix (e.g. "kbfun_press_release", or "press_release"), or
+ *   null.
+ * - A key given as a string, instead of a list, is shorthand for
+ *   `[ "<keycode>", "press_release", "press_release" ]`; a key given as null
+ *   is shorthand for `[ 0, null, null ]`.
+ * - A macro step given as a string is a keycode to tap (see
+ *   "lib/key-functions/private.h" for what each step does).
+ * - A '<character>' may be the character itself (e.g. "é"), its code point
+ *   (e.g. "U+00E9"), or a number.
+ * - When several keymaps are linked together, the LEDs, combos, macros,
+ *   unicode characters, leader sequences, tap-hold keys, and tap-dance keys
+ *   are taken from the first.
+ * ------------------------------------------------------------------------- */
+""")
+
+# -----------------------------------------------------------------------------
+
+import argparse
+import json
+import os
+import re
+import sys
+
+# -----------------------------------------------------------------------------
+
+MAX_LAYERS = 32  # must match the limit in "default--matrix-control.h"
+MAX_COMBOS = 8   # \ must match the limits in "default--matrix-control.h"
+MAX_COMBO_KEYS = 4  # /
+
+# macro bytecode (must match "lib/key-functions/private.h")
+MACRO_OPS = {
+	'down': 'MACRO_DOWN', 'up': 'MACRO_UP', 'delay': 'MACRO_DELAY',
+	'push': 'MACRO_LAYER_PUSH', 'pop': 'MACRO_LAYER_POP',
+	'shifted': 'MACRO_MODS, MACRO_BIT_SHIFT',
+	'altgr': 'MACRO_MODS, MACRO_BIT_ALTGR',
+}
+MACRO_FIRST_OP = 0xF0
+
+# key flags (must match "default--matrix-control.h")
+KEY_FLAG_TRANSPARENT_ABOVE_0 = 1<<0
+KEY_FLAG_STATIC = 1<<1
+
+# key functions that take the layer to push from the keycode
+LAYER_FUNCTION_RE = r'kbfun_layer_(push|sticky)(_\d+)?$'
+
+# key functions that take the index of an entry in a table from the keycode
+# (and the table; see `check_indices()`)
+INDEX_FUNCTIONS = {
+	'kbfun_macro_play': 'macros',
+	'kbfun_unicode': 'unicode',
+	'kbfun_tap_hold': 'tap_holds',
+	'kbfun_tap_dance': 'tap_dances',
+}
+
+# tap-hold flags (must match "default--matrix-control.h")
+TAP_HOLD_FLAGS = {
+	'permissive': 'KB_TAP_HOLD_FLAG_PERMISSIVE',
+	'on_other_key': 'KB_TAP_HOLD_FLAG_ON_OTHER_KEY',
+}
+
+# tap-dance keycodes, in `KB_TAP_DANCE()` order
+TAP_DANCE_FIELDS = ('tap', 'double_tap', 'triple_tap', 'hold', 'tap_hold')
+
+# the first line of the comment identifying generated files
+GENERATED_MARKER = 'Generated by "build-scripts/gen-layout-source.py"'
+
+LED_NAMES = ('num', 'caps', 'scroll', 'compose', 'kana')
+LED_DEFAULTS = { 'num': 1, 'caps': 2, 'scroll': 3, 'compose': 0, 'kana': 0 }
+
+# -----------------------------------------------------------------------------
+
+class KeymapError(Exception):
+	pass
+
+# -----------------------------------------------------------------------------
+
+def parse_matrix_file(matrix_file_path):
+	"""
+	Return the key-ids in physical order, and in matrix order (with 'na' for
+	unused positions), as given by the 'KB_MATRIX_LAYER' macro; and the
+	number of columns in the matrix ('KB_COLUMNS')
+	"""
+	text = open(matrix_file_path).read()
+	match = re.search(  # find the whole 'KB_MATRIX_LAYER' macro
+			r'#define\s+KB_MATRIX_LAYER\s*\(([^)]+)\)[^{]*\{\{([^#]+)\}\}',
+			text )
+	columns = re.search(r'#define\s+KB_COLUMNS\s+(\d+)', text)
+
+	return ( re.findall(r'k..', match.group(1)),
+			 re.findall(r'k..|na', match.group(2)),
+			 int(columns.group(1)) )
+
+def parse_keycode_names(source_code_path):
+	"""
+	Return a dictionary of keycode names (and short names) to values
+	"""
+	usage_page = os.path.join(source_code_path, 'lib', 'usb', 'usage-page')
+	names = {}
+
+	for line in open(os.path.join(usage_page, 'keyboard.h')):
+		match = re.match(
+				r'\s*#define\s+((?:KEY|KEYPAD|MEDIAKEY)_\w+)\s+(0x[0-9A-Fa-f]+)',
+				line )
+		if match:
+			names[match.group(1)] = int(match.group(2), 16)
+
+	for line in open(os.path.join(usage_page, 'keyboard--short-names.h')):
+		match = re.match(r'\s*#define\s+(_\w+)\s+((?:KEY|KEYPAD)_\w+)', line)
+		if match and match.group(2) in names:
+			names[match.group(1)] = names[match.group(2)]
+
+	return names
+
+def parse_key_functions(source_code_path):
+	"""
+	Return the set of key function names declared in the public header
+	"""
+	header = os.path.join(source_code_path, 'lib', 'key-functions', 'public.h')
+	return set( re.findall( r'void\s+(kbfun_\S+)\s*\(void\)',
+							open(header).read() ) )
+
+# -----------------------------------------------------------------------------
+
+def read_keymap(keymap_file_path):
+	"""
+	Return the keymap, normalized to the format described above (with the
+	'layers' in whatever order they were given in)
+	"""
+	keymap = json.load(open(keymap_file_path, encoding='utf-8'))
+
+	if 'layers' not in keymap:
+		try:  # a UI info file
+			keymap = {
+				'order': 'matrix',
+				'layers': keymap['mappings']['matrix-layout'],
+			}
+		except (KeyError, TypeError):
+			raise KeymapError("no 'layers' (or 'mappings.matrix-layout') found")
+
+	return keymap
+
+def normalize_layers(keymap, physical, matrix):
+	"""
+	Return the layers as lists of '[keycode, press, release]' in matrix order
+	(including unused positions), with shorthand keys expanded
+	"""
+	layers = keymap['layers']
+	order = keymap.get('order')
+
+	def expand(key):
+		if key is None:
+			return [0, None, None]
+		if not isinstance(key, list):
+			return [key, 'press_release', 'press_release']
+		if len(key) != 3:
+			raise KeymapError("key "+json.dumps(key)+" is not of the form "
+							  + "[keycode, press, release]")
+		return key
+
+	output = []
+	for (number, layer) in enumerate(layers):
+		if order is None:
+			order = ( 'physical' if len(layer) == len(physical)
+					  else 'matrix' )
+		if order == 'physical':
+			if len(layer) != len(physical):
+				raise KeymapError( "layer "+str(number)+" has "
+								 + str(len(layer))+" keys (expected "
+								 + str(len(physical))+", in physical order)" )
+			by_id = dict(zip(physical, layer))
+			layer = [by_id.get(kid) for kid in matrix]
+		elif order == 'matrix':
+			if len(layer) != len(matrix):
+				raise KeymapError( "layer "+str(number)+" has "
+								 + str(len(layer))+" keys (expected "
+								 + str(len(matrix))+", in matrix order)" )
+		else:
+			raise KeymapError("unknown order '"+str(order)+"'")
+
+		output.append([expand(key) for key in layer])
+
+	return output
+
+# -----------------------------------------------------------------------------
+
+def resolve_keycode(value, keycode_names, where):
+	"""
+	Return the value of the given keycode (a name, a number, or null)
+	"""
+	if value is None:
+		value = 0
+	elif isinstance(value, str):
+		if value in keycode_names:
+			value = keycode_names[value]
+		elif re.match(r'(0x[0-9A-Fa-f]+|\d+)$', value):
+			value = int(value, 0)
+		elif re.match(r"'.'$", value):  # character constant
+			value = ord(value[1])
+		else:
+			raise KeymapError(where+": unknown keycode '"+value+"'")
+	if not isinstance(value, int) or not 0 <= value <= 0xFF:
+		raise KeymapError(where+": keycode "+str(value)+" does not fit in a byte")
+	return value
+
+def resolve_layers(layers, matrix, keycode_names, key_functions):
+	"""
+	Replace keycode names with numbers and function names with full names,
+	checking each as we go, then check the keymap as a whole
+	"""
+	def where(number, position):
+		return "layer "+str(number)+", key "+matrix[position]
+
+	def resolve_function(value, number, position):
+		if value in (None, 'NULL', 'null'):
+			return None
+		value = value.lstrip('&')
+		if not value.startswith('kbfun_'):
+			value = 'kbfun_'+value
+		if value not in key_functions:
+			raise KeymapError( where(number, position)
+							 + ": unknown key function '"+value+"'" )
+		return value
+
+	output = [
+		[ [ resolve_keycode(code, keycode_names, where(number, position)),
+			resolve_function(press, number, position),
+			resolve_function(release, number, position) ]
+		  for (position, (code, press, release)) in enumerate(layer) ]
+		for (number, layer) in enumerate(layers) ]
+
+	# whole keymap checks
+	if not output:
+		raise KeymapError("no layers defined")
+	if len(output) > MAX_LAYERS:
+		raise KeymapError( str(len(output))+" layers defined (the limit is "
+						 + str(MAX_LAYERS)+")" )
+	for (number, layer) in enumerate(output):
+		for (position, (code, press, release)) in enumerate(layer):
+			if matrix[position] == 'na' and (press or release):
+				raise KeymapError( where(number, position)
+								 + ": unused matrix position has a function" )
+			if number == 0 and 'kbfun_transparent' in (press, release):
+				raise KeymapError( where(number, position)
+								 + ": transparent on layer 0 (there is "
+								 + "nothing beneath it)" )
+			for function in (press, release):
+				if ( function and re.match(LAYER_FUNCTION_RE, function)
+					 and code >= len(output) ):
+					raise KeymapError( where(number, position)
+									 + ": '"+function+"' to layer "
+									 + str(code)+", which is not defined" )
+
+	return output
+
+def resolve_combos(keymap, matrix, keycode_names):
+	"""
+	Return the combos as '(keycode, [matrix position, ...])', checked
+	"""
+	combos = keymap.get('combos', [])
+	if len(combos) > MAX_COMBOS:
+		raise KeymapError( str(len(combos))+" combos defined (the limit is "
+						 + str(MAX_COMBOS)+")" )
+
+	output = []
+	for (number, combo) in enumerate(combos):
+		where = "combo "+str(number)
+		keys = combo.get('keys', [])
+		if not 2 <= len(keys) <= MAX_COMBO_KEYS:
+			raise KeymapError( where+": has "+str(len(keys))+" keys (2 to "
+							 + str(MAX_COMBO_KEYS)+" allowed)" )
+		for kid in keys:
+			if kid not in matrix or kid == 'na':
+				raise KeymapError(where+": unknown key '"+str(kid)+"'")
+		if len(set(keys)) != len(keys):
+			raise KeymapError(where+": has the same key more than once")
+		if sorted(keys) in [sorted(other) for (code, other) in output]:
+			raise KeymapError(where+": has the same keys as another combo")
+		output.append(( resolve_keycode( combo.get('keycode'), keycode_names,
+										 where ),
+						[matrix.index(kid) for kid in keys] ))
+	return output
+
+def resolve_macros(keymap, keycode_names, layer_count):
+	"""
+	Return the macros as lists of C expressions (the bytes of each program,
+	without the terminating 'MACRO_END')
+	"""
+	output = []
+	for (number, macro) in enumerate(keymap.get('macros', [])):
+		where = "macro "+str(number)
+		program = []
+		for step in macro:
+			if not isinstance(step, dict):
+				code = resolve_keycode(step, keycode_names, where)
+				if not 0 < code < MACRO_FIRST_OP:
+					raise KeymapError( where+": keycode "+str(code)
+									 + " can't be tapped in a macro" )
+				program.append('0x{:02X}'.format(code))
+				continue
+			if len(step) != 1 or list(step)[0] not in MACRO_OPS:
+				raise KeymapError(where+": unknown step "+json.dumps(step))
+			(op, value) = list(step.items())[0]
+			program.append(MACRO_OPS[op])
+			if op in ('delay', 'push'):
+				if not isinstance(value, int) or not 0 <= value <= 0xFF:
+					raise KeymapError( where+": '"+op+"' needs a number "
+									 + "(0 to 255)" )
+				if op == 'push' and value >= layer_count:
+					raise KeymapError( where+": push to layer "+str(value)
+									 + ", which is not defined" )
+				program.append(str(value))
+			elif op != 'pop':
+				program.append( '0x{:02X}'.format(
+						resolve_keycode(value, keycode_names, where) ) )
+		output.append(program)
+	return output
+
+def resolve_unicode(keymap):
+	"""
+	Return the unicode characters, as a list of code points
+	"""
+	output = []
+	for (number, character) in enumerate(keymap.get('unicode', [])):
+		where = "unicode character "+str(number)
+		if isinstance(character, str) and len(character) == 1:
+			code = ord(character)
+		elif isinstance(character, str) and re.match(r'[Uu]\+[0-9A-Fa-f]+$',
+													 character):
+			code = int(character[2:], 16)
+		elif isinstance(character, int):
+			code = character
+		else:
+			raise KeymapError( where+": "+json.dumps(character)
+							 + " is not a character, or a code point" )
+		if not 0 < code <= 0x10FFFF or 0xD800 <= code <= 0xDFFF:
+			raise KeymapError( where+": U+{:04X} is not a valid ".format(code)
+							 + "code point" )
+		output.append(code)
+	return output
+
+def resolve_leader(keymap, keycode_names, macro_count):
+	"""
+	Return the leader sequences' trie, as a list of bytes (see
+	"default--matrix-control.h" for the format)
+	"""
+	root = {'action': 0, 'children': {}}
+	for (number, sequence) in enumerate(keymap.get('leader', [])):
+		where = "leader sequence "+str(number)
+		keys = sequence.get('keys', [])
+		macro = sequence.get('macro')
+		if not keys:
+			raise KeymapError(where+": has no keys")
+		if not isinstance(macro, int) or not 0 <= macro < macro_count:
+			raise KeymapError(where+": macro "+str(macro)+" is not defined")
+		node = root
+		for key in keys:
+			code = resolve_keycode(key, keycode_names, where)
+			node = node['children'].setdefault(
+					code, {'action': 0, 'children': {}} )
+		if node['action']:
+			raise KeymapError(where+": same keys as another sequence")
+		node['action'] = macro+1
+
+	# breadth first, so every node's offset is known before it's written
+	nodes = [root]
+	for node in nodes:
+		nodes.extend(node['children'][code] for code in sorted(node['children']))
+	offset = 0
+	for node in nodes:
+		node['offset'] = offset
+		offset += 2 + 2*len(node['children'])
+	if offset > 0x100:
+		raise KeymapError( "leader sequences take "+str(offset)+" bytes "
+						 + "(the limit is 256)" )
+
+	output = []
+	for node in nodes:
+		output += [node['action'], len(node['children'])]
+		for code in sorted(node['children']):
+			output += [code, node['children'][code]['offset']]
+	return output if len(nodes) > 1 else []
+
+def resolve_tap_holds(keymap, keycode_names, layer_count):
+	"""
+	Return the tap-hold keys as '(tap keycode, hold keycode or layer, is
+	layer, [flag, ...])', checked
+	"""
+	output = []
+	for (number, entry) in enumerate(keymap.get('tap_holds', [])):
+		where = "tap-hold "+str(number)
+		if ('hold' in entry) == ('layer' in entry):
+			raise KeymapError(where+": needs either a 'hold', or a 'layer'")
+		if 'layer' in entry:
+			hold = entry['layer']
+			if not isinstance(hold, int) or not 0 <= hold < layer_count:
+				raise KeymapError( where+": layer "+str(hold)
+								 + " is not defined" )
+		else:
+			hold = resolve_keycode(entry['hold'], keycode_names, where)
+		flags = entry.get('flags', [])
+		for flag in flags:
+			if flag not in TAP_HOLD_FLAGS:
+				raise KeymapError(where+": unknown flag "+json.dumps(flag))
+		output.append(( resolve_keycode(entry.get('tap'), keycode_names,
+										 where ),
+						hold, 'layer' in entry,
+						[TAP_HOLD_FLAGS[flag] for flag in flags] ))
+	return output
+
+def resolve_tap_dances(keymap, keycode_names):
+	"""
+	Return the tap-dance keys as lists of keycodes (see `TAP_DANCE_FIELDS`)
+	"""
+	output = []
+	for (number, entry) in enumerate(keymap.get('tap_dances', [])):
+		where = "tap-dance "+str(number)
+		for field in entry:
+			if field not in TAP_DANCE_FIELDS:
+				raise KeymapError(where+": unknown field "+json.dumps(field))
+		output.append([ resolve_keycode(entry.get(field), keycode_names,
+										where )
+						for field in TAP_DANCE_FIELDS ])
+	return output
+
+def check_indices(layers, matrix, counts):
+	"""
+	Check that every key whose keycode is the index of an entry in a table
+	(see `INDEX_FUNCTIONS`) has an entry there
+	"""
+	for (number, layer) in enumerate(layers):
+		for (position, (code, press, release)) in enumerate(layer):
+			for function in (press, release):
+				table = INDEX_FUNCTIONS.get(function)
+				if table and code >= counts[table]:
+					raise KeymapError( "layer "+str(number)+", key "
+									 + matrix[position]+": '"+function
+									 + "' to entry "+str(code)+" of '"
+									 + table+"', which is not defined" )
+
+# -----------------------------------------------------------------------------
+
+def link_keymaps(keymaps):
+	"""
+	Return the layers of all the keymaps (lists of layers) with duplicates
+	removed, and for each keymap a list mapping its layer numbers to indices
+	in that list
+
+	A layer is only shared between keymaps where it is the base layer of all
+	of them, or of none (so each stored layer is either a base layer or not,
+	for 'gen_key_flags()')
+	"""
+	if len(keymaps) == 1:  # nothing to link (and no translation at runtime)
+		return (keymaps[0], [list(range(len(keymaps[0])))])
+
+	layers = []
+	bases = []  # whether each stored layer is a base layer
+	tables = []
+	for keymap in keymaps:
+		table = []
+		for (number, layer) in enumerate(keymap):
+			base = (number == 0)
+			index = next( ( index for index in range(len(layers))
+							if layers[index] == layer
+							and bases[index] == base ), None )
+			if index is None:
+				index = len(layers)
+				layers.append(layer)
+				bases.append(base)
+			table.append(index)
+		tables.append(table)
+
+	if len(layers) > MAX_LAYERS:
+		raise KeymapError( str(len(layers))+" distinct layers defined by the "
+						 + "keymaps together (the limit is "
+						 + str(MAX_LAYERS)+")" )
+
+	return (layers, tables)
+
+# -----------------------------------------------------------------------------
+
+def gen_key_flags(layers, bases):
+	"""
+	Return the per-key flags, in matrix order
+
+	- 'TRANSPARENT_ABOVE_0': transparent (press and release) on every layer but
+	  the base layers (of each keymap), so the key always resolves to the base
+	  layer, whatever is on the stack
+	- 'STATIC': identical on every layer (and not transparent), so the layer
+	  stack need not be consulted at all
+	"""
+	flags = []
+	for position in range(len(layers[0])):
+		keys = [layer[position] for layer in layers]
+		above = [ key for (number, key) in enumerate(keys)
+				  if number not in bases ]
+		flag = 0
+		if ( above
+			 and all( press == release == 'kbfun_transparent'
+					  for (code, press, release) in above ) ):
+			flag |= KEY_FLAG_TRANSPARENT_ABOVE_0
+		if all(key == keys[0] for key in keys):
+			flag |= KEY_FLAG_STATIC
+		flags.append(flag)
+	return flags
+
+# -----------------------------------------------------------------------------
+
+def gen_header_comment(title, sources, descriptions):
+	return '\n'.join([
+		'/* ----------------------------------------------------------------------------',
+		' * ergoDOX : layout : '+title,
+		' * ----------------------------------------------------------------------------',
+		' * '+GENERATED_MARKER+' (edit the keymaps, not',
+		' * this file) from',
+	] + [ ' * - "'+source+'"' + (': '+description if description else '')
+		  for (source, description)
+		  in zip(sources, descriptions or [None]*len(sources)) ] + [
+		' * ------------------------------------------------------------------------- */',
+		'',
+	])
+
+def gen_matrix(name, c_type, layers, physical, matrix, element):
+	"""
+	Return the C definition of one layout matrix, one 'KB_MATRIX_LAYER' per
+	layer (in physical order, as in the hand written layouts)
+	"""
+	lines = ['const '+c_type+' PROGMEM '+name+'[][KB_ROWS][KB_COLUMNS] = {']
+	for (number, layer) in enumerate(layers):
+		by_id = dict(zip(matrix, layer))
+		values = [element(by_id[kid]) for kid in physical]
+		lines.append('// LAYER '+str(number))
+		lines.append('KB_MATRIX_LAYER(')
+		lines.append('\t'+element(None)+',')
+		for start in range(0, len(values), 7):
+			lines.append('\t'+', '.join(values[start:start+7])
+						 + (',' if start+7 < len(values) else '') )
+		lines.append('),')
+	lines.append('};')
+	return '\n'.join(lines)
+
+def gen_keymap_tables(tables):
+	width = max(len(table) for table in tables)
+	return '\n'.join([
+		'// layer-number to stored layer, for each keymap (see "KB_KEYMAPS")',
+		'const uint8_t PROGMEM _kb_keymap_layers[KB_KEYMAPS][KB_KEYMAP_LAYERS] = {',
+		',\n'.join( '\t{ '+', '.join(str(n) for n in table
+										+ [0]*(width-len(table)) )+' }'
+					for table in tables ),
+		'};',
+		'',
+		'const uint8_t PROGMEM _kb_keymap_layer_counts[KB_KEYMAPS] = {',
+		'\t'+', '.join(str(len(table)) for table in tables),
+		'};',
+		'',
+	])
+
+def gen_combos(combos, matrix, columns):
+	keys = [0] * len(matrix)
+	for (number, (code, positions)) in enumerate(combos):
+		for position in positions:
+			keys[position] |= 1 << number
+	rows = [ keys[start:start+columns]
+			 for start in range(0, len(keys), columns) ]
+
+	return '\n'.join([
+		'// in matrix order; bit `n` set for the keys in combo `n`',
+		'const uint8_t PROGMEM _kb_layout_combo_keys[KB_ROWS][KB_COLUMNS] = {',
+		',\n'.join( '\t{ '+', '.join(str(k) for k in row)+' }'
+					for row in rows ),
+		'};',
+		'',
+		'// keycode, number of keys (see "KB_COMBO_*")',
+		'const uint8_t PROGMEM _kb_layout_combos[][2] = {',
+		',\n'.join( '\t{{ 0x{:02X}, {} }}'.format(code, len(positions))
+					for (code, positions) in combos ),
+		'};',
+		'',
+	])
+
+def gen_macros(macros):
+	lines = []
+	for (number, program) in enumerate(macros):
+		lines.append( 'static const uint8_t PROGMEM _kb_layout_macro_'
+					  + str(number)+'[] = {' )
+		lines.append('\t'+', '.join(program + ['MACRO_END'])+' };')
+	lines.append('')
+	lines.append('const uint8_t * const PROGMEM _kb_layout_macros[] = {')
+	lines.append( ',\n'.join( '\t_kb_layout_macro_'+str(number)
+							  for number in range(len(macros)) ) )
+	lines.append('};')
+	lines.append('')
+	return '\n'.join(lines)
+
+def gen_unicode(unicode):
+	return '\n'.join([
+		'const uint32_t PROGMEM _kb_layout_unicode[] = {',
+		',\n'.join( '\t0x{:06X}'.format(code) for code in unicode ),
+		'};',
+		'',
+	])
+
+def gen_leader(trie):
+	return '\n'.join([
+		'// a trie (see "default--matrix-control.h")',
+		'const uint8_t PROGMEM _kb_layout_leader[] = {',
+		',\n'.join( '\t'+', '.join(str(b) for b in trie[start:start+16])
+					for start in range(0, len(trie), 16) ),
+		'};',
+		'',
+	])
+
+def gen_tap_holds(tap_holds):
+	def entry(tap, hold, is_layer, flags):
+		return ( 'KB_TAP_HOLD_'+('LAYER' if is_layer else 'KEY')
+				 + '( 0x{:02X}, {}, {} )'.format(
+						 tap, hold if is_layer else '0x{:02X}'.format(hold),
+						 ' | '.join(flags) or '0' ) )
+	return '\n'.join([
+		'// see "KB_TAP_HOLD_*"',
+		'const uint8_t PROGMEM _kb_layout_tap_holds[][3] = {',
+		',\n'.join( '\t'+entry(*tap_hold) for tap_hold in tap_holds ),
+		'};',
+		'',
+	])
+
+def gen_tap_dances(tap_dances):
+	return '\n'.join([
+		'// see "KB_TAP_DANCE*"',
+		'const uint8_t PROGMEM _kb_layout_tap_dances[][5] = {',
+		',\n'.join( '\tKB_TAP_DANCE( '
+					+ ', '.join('0x{:02X}'.format(code) for code in codes)
+					+ ' )' for codes in tap_dances ),
+		'};',
+		'',
+	])
+
+def gen_source( title, sources, descriptions, layers, tables, flags,
+				combos, macros, unicode, leader, tap_holds, tap_dances,
+				physical, matrix, columns ):
+	def keycode(key):
+		return '0' if key is None else '0x{:02X}'.format(key[0])
+	def function(index):
+		def f(key):
+			if key is None or key[index] is None:
+				return 'NULL'
+			return '&'+key[index]
+		return f
+
+	matrix_flags = [ flags[position] for position in range(len(matrix)) ]
+	flag_rows = [ matrix_flags[start:start+columns]
+				  for start in range(0, len(matrix_flags), columns) ]
+
+	return '\n'.join([
+		gen_header_comment(title, sources, descriptions),
+		'',
+		'#include <stdint.h>',
+		'#include <stddef.h>',
+		'#include <avr/pgmspace.h>',
+		'#include "../../../lib/data-types/misc.h"',
+		'#include "../../../lib/key-functions/public.h"',
+		'#include "../../../lib/key-functions/private.h"',
+		'#include "../matrix.h"',
+		'#include "../layout.h"',
+		'',
+		'// ----------------------------------------------------------------------------',
+		'',
+		gen_matrix('_kb_layout', 'uint8_t', layers, physical, matrix, keycode),
+		'',
+		'// ----------------------------------------------------------------------------',
+		'',
+		gen_matrix('_kb_layout_press', 'void_funptr_t', layers, physical,
+				   matrix, function(1)),
+		'',
+		'// ----------------------------------------------------------------------------',
+		'',
+		gen_matrix('_kb_layout_release', 'void_funptr_t', layers, physical,
+				   matrix, function(2)),
+		'',
+		'// ----------------------------------------------------------------------------',
+		'',
+		'// in matrix order (see "KB_LAYOUT_KEY_FLAG_*")',
+		'const uint8_t PROGMEM _kb_layout_key_flags[KB_ROWS][KB_COLUMNS] = {',
+		',\n'.join( '\t{ '+', '.join(str(f) for f in row)+' }'
+					for row in flag_rows ),
+		'};',
+		'',
+	] + ( [ '// ----------------------------------------------------------------------------',
+			'',
+			gen_keymap_tables(tables) ] if len(tables) > 1 else [] ) + (
+	  [ '// ----------------------------------------------------------------------------',
+			'',
+			gen_combos(combos, matrix, columns) ] if combos else [] ) + (
+	  [ '// ----------------------------------------------------------------------------',
+			'',
+			gen_macros(macros) ] if macros else [] ) + (
+	  [ '// ----------------------------------------------------------------------------',
+			'',
+			gen_unicode(unicode) ] if unicode else [] ) + (
+	  [ '// ----------------------------------------------------------------------------',
+			'',
+			gen_leader(leader) ] if leader else [] ) + (
+	  [ '// ----------------------------------------------------------------------------',
+			'',
+			gen_tap_holds(tap_holds) ] if tap_holds else [] ) + (
+	  [ '// ----------------------------------------------------------------------------',
+			'',
+			gen_tap_dances(tap_dances) ] if tap_dances else [] ) + [
+		'KB_LAYOUT_LAYERS_DEFINE();',
+		'',
+	])
+
+def gen_header(title, sources, leds, tables, combos, leader):
+	guard = 'KEYBOARD__ERGODOX__LAYOUT__' \
+			+ re.sub(r'\W', '_', title).upper() + '_h'
+
+	led_lines = []
+	for name in LED_NAMES:
+		number = leds.get(name, LED_DEFAULTS[name])
+		if not number:
+			continue
+		for state in ('on', 'off'):
+			led_lines.append(
+				'\t#define kb_led_{0}_{1}()'.format(name, state).ljust(30)
+				+ '_kb_led_{0}_{1}()'.format(number, state) )
+
+	return '\n'.join([
+		gen_header_comment(title, sources, []),
+		'',
+		'#ifndef '+guard,
+		'\t#define '+guard,
+		'',
+		'\t#include "../controller.h"',
+		'',
+		'\t// --------------------------------------------------------------------',
+		'',
+		'\n'.join(led_lines),
+		'',
+		'\t// --------------------------------------------------------------------',
+		'',
+		'\t#define KB_LAYOUT_HAS_KEY_FLAGS',
+	] + ( [ '\t#define KB_LAYOUT_HAS_COMBOS' ] if combos else [] ) + (
+		  [ '\t#define KB_LAYOUT_HAS_LEADER' ] if leader else [] ) + ( [ '',
+			'\t#define KB_KEYMAPS        '+str(len(tables)),
+			'\t#define KB_KEYMAP_LAYERS  '
+				+ str(max(len(table) for table in tables)) ]
+		  if len(tables) > 1 else [] ) + [
+		'',
+		'\t// --------------------------------------------------------------------',
+		'',
+		'\t#include "./default--led-control.h"',
+		'\t#include "./default--matrix-control.h"',
+		'',
+		'#endif',
+		'',
+	])
+
+# -----------------------------------------------------------------------------
+
+def main():
+	arg_parser = argparse.ArgumentParser(
+			description = "Generate a layout's source from a keymap file" )
+
+	arg_parser.add_argument(
+			'--keymap-file-path',
+			help = ( "the path to the keymap ('.json') file; may be given "
+				   + "more than once, to link several keymaps together "
+				   + "(the first is the default)" ),
+			action = 'append',
+			required = True )
+	arg_parser.add_argument(
+			'--source-code-path',
+			help = "the path to the source code directory",
+			required = True )
+	arg_parser.add_argument(
+			'--matrix-file-path',
+			help = "the path to the matrix file we're using",
+			required = True )
+	arg_parser.add_argument(
+			'--output-c-file-path',
+			help = "where to write the layout '.c' file",
+			required = True )
+	arg_parser.add_argument(
+			'--output-h-file-path',
+			help = "where to write the layout '.h' file",
+			required = True )
+
+	args = arg_parser.parse_args(sys.argv[1:])
+
+	title = os.path.splitext(os.path.basename(args.output_c_file_path))[0]
+	sources = [os.path.basename(path) for path in args.keymap_file_path]
+	(physical, matrix, columns) = parse_matrix_file(args.matrix_file_path)
+	keycode_names = parse_keycode_names(args.source_code_path)
+	key_functions = parse_key_functions(args.source_code_path)
+
+	keymaps = []
+	keymaps_layers = []
+	for path in args.keymap_file_path:
+		try:
+			keymap = read_keymap(path)
+			keymaps.append(keymap)
+			keymaps_layers.append( resolve_layers(
+					normalize_layers(keymap, physical, matrix),
+					matrix, keycode_names, key_functions ) )
+			if len(keymaps) == 1:
+				combos = resolve_combos(keymap, matrix, keycode_names)
+				macros = resolve_macros( keymap, keycode_names,
+										 len(keymaps_layers[0]) )
+				unicode = resolve_unicode(keymap)
+				leader = resolve_leader(keymap, keycode_names, len(macros))
+				tap_holds = resolve_tap_holds( keymap, keycode_names,
+											   len(keymaps_layers[0]) )
+				tap_dances = resolve_tap_dances(keymap, keycode_names)
+			check_indices( keymaps_layers[-1], matrix, {
+					'macros': len(macros), 'unicode': len(unicode),
+					'tap_holds': len(tap_holds),
+					'tap_dances': len(tap_dances) } )
+		except KeymapError as e:
+			print(path+': error: '+str(e), file=sys.stderr)
+			sys.exit(1)
+
+	try:
+		(layers, tables) = link_keymaps(keymaps_layers)
+	except KeymapError as e:
+		print(title+': error: '+str(e), file=sys.stderr)
+		sys.exit(1)
+
+	flags = gen_key_flags(layers, set(table[0] for table in tables))
+
+	# don't clobber a hand written layout of the same name
+	for path in (args.output_c_file_path, args.output_h_file_path):
+		if ( os.path.exists(path)
+			 and GENERATED_MARKER not in open(path).read(1024) ):
+			print( path+': error: exists, and was not generated (choose '
+				 + 'another layout name)', file=sys.stderr )
+			sys.exit(1)
+
+	with open(args.output_c_file_path, 'w') as f:
+		f.write(gen_source( title, sources,
+							[keymap.get('description') for keymap in keymaps],
+							layers, tables, flags, combos, macros, unicode,
+							leader, tap_holds, tap_dances, physical, matrix,
+							columns ))
+	with open(args.output_h_file_path, 'w') as f:
+		# the LEDs (and the combos, macros, unicode characters, leader
+		# sequences, tap-hold keys, and tap-dance keys) are the same for all
+		# keymaps (taken from the first)
+		f.write(gen_header( title, sources, keymaps[0].get('leds', {}),
+							tables, combos, leader ))
+
+# -----------------------------------------------------------------------------
+
+if __name__ == '__main__':
+	main()
@@ -10,6 +10,8 @@ Generate a depiction of the layout (in html + svg)
 
 Depends on:
 - the UI info file (in JSON)
+- optionally, a heatmap file: the output of 'kbfun_heatmap_dump' (lines
+  ending in "<row> <column> <count>"; anything else is ignored)
 """
 
 # -----------------------------------------------------------------------------
@@ -40,6 +42,10 @@ def main():
 			'--ui-info-file',
 			required = True )
 
+	arg_parser.add_argument(
+			'--heatmap-file',
+			help = "shade each key by how often it was pressed" )
+
 	args = arg_parser.parse_args(sys.argv[1:])
 
 	# constant file paths
@@ -50,6 +56,8 @@ def main():
 	args.ui_info_file = os.path.abspath(args.ui_info_file)
 	args.template_svg_file = os.path.abspath(args.template_svg_file)
 	args.template_js_file = os.path.abspath(args.template_js_file)
+	if args.heatmap_file:
+		args.heatmap_file = os.path.abspath(args.heatmap_file)
 
 	# set vars
 	doc.main = ''  # to store the html document we're generating
@@ -60,6 +68,11 @@ def main():
 	info.matrix_positions = info.all['mappings']['matrix-positions']
 	info.matrix_layout = info.all['mappings']['matrix-layout']
 
+	# shade the keys (the same on every layer, since the counts are by
+	# matrix position)
+	if args.heatmap_file:
+		template.svg = heatmap(template.svg, open(args.heatmap_file).read())
+
 	# prefix
 	doc.prefix = ("""
 <?xml version="1.0" encoding="UTF-8" standalone="no"?>
@@ -180,6 +193,31 @@ def main():
 
 	print(doc.prefix + doc.main + doc.suffix)
 
+# -----------------------------------------------------------------------------
+
+def heatmap(svg, dump):
+	"""
+	Shade the key outlines in the given svg, from white (not pressed) to red
+	(pressed most), by the counts in the given dump (see
+	'kbfun_heatmap_dump')
+	"""
+	counts = {}
+	for (row, column, count) in re.findall(
+			r'(\d+)\s+(\d+)\s+(\d+)\s*$', dump, re.MULTILINE ):
+		counts['k%X%X' % (int(row), int(column))] = int(count)
+
+	most = max(counts.values(), default=0) or 1
+
+	def shade(match):
+		rect = match.group(0)
+		count = counts.get(match.group(1), 0)
+		return re.sub(
+				r'fill:#[0-9a-fA-F]{6};fill-opacity:[0-9.]+',
+				'fill:#ff0000;fill-opacity:%.2f' % (count / most * 0.8),
+				rect )
+
+	return re.sub(r'<rect[^>]*id="rect-(k..)"[^>]*>', shade, svg)
+
 # -----------------------------------------------------------------------------
 # -----------------------------------------------------------------------------
 
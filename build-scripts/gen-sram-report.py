@@ -0,0 +1,128 @@
+#! /usr/bin/env python3
+# -----------------------------------------------------------------------------
+# Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+# Released under The MIT License (MIT) (see "license.md")
+# Project located at <https://github.com/benblazak/ergodox-firmware>
+# -----------------------------------------------------------------------------
+
+"""
+Generate a report of the SRAM used by each module (in plain text)
+
+Depends on:
+- the project '.map' file (generated by the linker)
+
+Notes:
+- Counts the '.data', '.bss', and '.noinit' input sections kept by the linker
+  (i.e. static variables), by the object file they came from.  Whatever SRAM
+  is left over is the stack's (see "src/lib/stack.h" for how much of it has
+  been used, at runtime).
+"""
+
+# -----------------------------------------------------------------------------
+
+import argparse
+import os
+import re
+import sys
+
+# -----------------------------------------------------------------------------
+
+SECTIONS = ('.data', '.bss', '.noinit')
+
+def parse_mapfile(map_file_path):
+	"""
+	Return a dictionary of the form
+		{ <module> : { <output section> : <size in bytes> } }
+	"""
+	modules = {}
+
+	section = None  # the output section we're in
+	pending = None  # an input section name, with the rest on the next line
+	in_map = False  # (the "discarded input sections" come first)
+
+	for line in open(map_file_path):
+		line = line.rstrip('\n')
+
+		if line.startswith('Linker script and memory map'):
+			in_map = True
+			continue
+		if not in_map:
+			continue
+
+		# output sections start in the first column
+		match = re.match(r'^(\.\S+)', line)
+		if match:
+			section = match.group(1)
+			pending = None
+			continue
+
+		if section not in SECTIONS:
+			continue
+
+		# an input section (e.g. " .bss._counts  0x00800124  0xa8  lib/x.o"),
+		# possibly with its name on a line of its own
+		match = re.match(
+				r'^ (\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$',
+				line )
+		if match and (match.group(1) or pending) \
+				and not match.group(4).startswith('load address'):
+			size = int(match.group(3), 16)
+			module = match.group(4).strip()
+			# shorten e.g. '/usr/lib/.../libc.a(strlen.o)' to 'libc.a(strlen.o)'
+			module = re.sub(r'^.*/([^/(]+\(.*\))$', r'\1', module)
+			if size:
+				sizes = modules.setdefault(module, {})
+				sizes[section] = sizes.get(section, 0) + size
+			pending = None
+		elif re.match(r'^ (\S+)$', line):
+			pending = line.strip()
+		else:
+			pending = None
+
+	return modules
+
+# -----------------------------------------------------------------------------
+
+def main():
+	arg_parser = argparse.ArgumentParser(
+			description = "Report the SRAM used by each module of the "
+			            + "firmware, from the linker's map file" )
+
+	arg_parser.add_argument(
+			'--map-file-path',
+			help = "the path to the '.map' file",
+			required = True )
+	arg_parser.add_argument(
+			'--sram-size',
+			help = "in bytes (default: 2560, for the ATmega32U4)",
+			type = int,
+			default = 2560 )
+
+	args = arg_parser.parse_args(sys.argv[1:])
+
+	args.map_file_path = os.path.abspath(args.map_file_path)
+	if not os.path.exists(args.map_file_path):
+		raise ValueError("invalid 'map_file_path' given")
+
+	modules = parse_mapfile(args.map_file_path)
+
+	rows = sorted( ( (sum(sizes.values()),) +
+	                 tuple(sizes.get(s, 0) for s in SECTIONS) +
+	                 (module,)
+	                 for (module, sizes) in modules.items() ),
+	               reverse = True )
+	total = sum(row[0] for row in rows)
+
+	print('%6s %6s %6s %6s  %s' % (('total',) + SECTIONS + ('module',)))
+	for row in rows:
+		print('%6d %6d %6d %6d  %s' % row)
+	print()
+	print('%6d bytes used by static variables' % total)
+	print('%6d bytes left for the stack (of %d)'
+	      % (args.sram_size - total, args.sram_size))
+
+# -----------------------------------------------------------------------------
+
+if __name__ == '__main__':
+	main()
+
@@ -9,6 +9,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "../../lib/profile.h"
 #include "./matrix.h"
 #include "./controller/mcp23018--functions.h"
 #include "./controller/teensy-2-0--functions.h"
@@ -35,9 +36,20 @@ uint8_t kb_init(void) {
 uint8_t kb_update_matrix(bool matrix[KB_ROWS][KB_COLUMNS]) {
 	if (teensy_update_matrix(matrix))
 		return 1;
+	profile_mark(PROFILE_MATRIX_TEENSY);
 	if (mcp23018_update_matrix(matrix))
 		return 2;
+	profile_mark(PROFILE_MATRIX_MCP23018);
 
 	return 0;  // success
 }
 
+/* returns
+ * - whether any key is pressed (or a scan is needed for some other reason)
+ *
+ * notes
+ * - much quicker than `kb_update_matrix()`: for checking often, while idle.
+ */
+bool kb_any_key_pressed(void) {
+	return teensy_any_pressed() || mcp23018_any_pressed();
+}
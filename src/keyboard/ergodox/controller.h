@@ -22,6 +22,7 @@
 
 	uint8_t kb_init(void);
 	uint8_t kb_update_matrix(bool matrix[KB_ROWS][KB_COLUMNS]);
+	bool    kb_any_key_pressed(void);
 
 #endif
 
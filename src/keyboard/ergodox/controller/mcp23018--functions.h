@@ -22,6 +22,7 @@
 
 	uint8_t mcp23018_init(void);
 	uint8_t mcp23018_update_matrix( bool matrix[KB_ROWS][KB_COLUMNS] );
+	bool    mcp23018_any_pressed(void);
 
 #endif
 
@@ -39,72 +39,162 @@
 #define TWI_ADDR_WRITE ( (MCP23018_TWI_ADDRESS<<1) | TW_WRITE )
 #define TWI_ADDR_READ  ( (MCP23018_TWI_ADDRESS<<1) | TW_READ  )
 
+// do a twi operation; on failure, give up on the rest of the block
+#define TRY(expression)  do { if ((ret = (expression))) goto out; } while (0)
+
+// the most scans to skip, after failing, before trying again; reached after
+// 8 failures in a row (about 70 scans), when the left hand is given up on
+// (see `mcp23018_update_matrix()`)
+#define BACKOFF_MAX  128
+
+// ----------------------------------------------------------------------------
+
+static uint8_t _backoff;  // scans to skip after the next failure
+static uint8_t _skip;     // scans left to skip
+static uint8_t _error;    // the last failure (0 if the last try worked)
+
+static uint8_t _last[6];  // our part of the matrix, as last read (bit `col`
+                          //   of each row, set if pressed)
+
+static bool _low;  // whether all the rows (or columns) are being driven low
+                   //   (see `mcp23018_any_pressed()`)
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Note a failure (and how long to leave the bus alone for, because of it)
+ */
+static void _fail(uint8_t error) {
+	_error = error;
+	_skip = _backoff;
+	_backoff = !_backoff ? 1 : (_backoff < BACKOFF_MAX) ? _backoff*2 : _backoff;
+}
+
+/*
+ * Write the given values to the given register pair
+ *
+ * Returns
+ * - success: 0
+ * - failure: twi status code, or `TWI_ERROR_*`
+ */
+static uint8_t _write(uint8_t reg, uint8_t a, uint8_t b) {
+	uint8_t ret;
+
+	TRY( twi_start() );
+	TRY( twi_send(TWI_ADDR_WRITE) );  // make sure we got an ACK
+	TRY( twi_send(reg) );
+	TRY( twi_send(a) );
+	TRY( twi_send(b) );
+
+out:
+	twi_stop();
+	return ret;
+}
+
+/*
+ * Read the given register
+ *
+ * Returns
+ * - success: 0
+ * - failure: twi status code, or `TWI_ERROR_*`
+ */
+static uint8_t _read(uint8_t reg, uint8_t * data) {
+	uint8_t ret;
+
+	TRY( twi_start() );
+	TRY( twi_send(TWI_ADDR_WRITE) );
+	TRY( twi_send(reg) );
+	TRY( twi_start() );
+	TRY( twi_send(TWI_ADDR_READ) );
+	TRY( twi_read(data) );
+
+out:
+	twi_stop();
+	return ret;
+}
+
+/*
+ * Write the given value to the given register, then read the next register
+ *
+ * Returns
+ * - success: 0
+ * - failure: twi status code, or `TWI_ERROR_*`
+ */
+static uint8_t _write_read(uint8_t reg, uint8_t value, uint8_t * data) {
+	uint8_t ret;
+
+	TRY( twi_start() );
+	TRY( twi_send(TWI_ADDR_WRITE) );
+	TRY( twi_send(reg) );
+	TRY( twi_send(value) );
+	twi_stop();
+
+	return _read(reg ^ 1, data);  // (GPIOA <-> GPIOB)
+
+out:
+	twi_stop();
+	return ret;
+}
+
 // ----------------------------------------------------------------------------
 
 /* returns:
  * - success: 0
- * - failure: twi status code
+ * - failure: twi status code, or `TWI_ERROR_*`
  *
  * notes:
  * - `twi_stop()` must be called *exactly once* for each twi block, the way
  *   things are currently set up.  this may change in the future.
+ * - each block gives up at the first operation that fails, so a glitching
+ *   (or unplugged) left hand costs at most about one `TWI_TIMEOUT` here.
  */
 uint8_t mcp23018_init(void) {
 	uint8_t ret;
 
+	_low = false;  // (set hi-Z, below)
+
 	// set pin direction
 	// - unused  : input  : 1
 	// - input   : input  : 1
 	// - driving : output : 0
-	twi_start();
-	ret = twi_send(TWI_ADDR_WRITE);
-	if (ret) goto out;  // make sure we got an ACK
-	twi_send(IODIRA);
 	#if MCP23018__DRIVE_ROWS
-		twi_send(0b11111111);  // IODIRA
-		twi_send(0b11000000);  // IODIRB
+		ret = _write(IODIRA, 0b11111111, 0b11000000);
 	#elif MCP23018__DRIVE_COLUMNS
-		twi_send(0b10000000);  // IODIRA
-		twi_send(0b11111111);  // IODIRB
+		ret = _write(IODIRA, 0b10000000, 0b11111111);
 	#endif
-	twi_stop();
+	if (ret) return ret;
 
 	// set pull-up
 	// - unused  : on  : 1
 	// - input   : on  : 1
 	// - driving : off : 0
-	twi_start();
-	ret = twi_send(TWI_ADDR_WRITE);
-	if (ret) goto out;  // make sure we got an ACK
-	twi_send(GPPUA);
 	#if MCP23018__DRIVE_ROWS
-		twi_send(0b11111111);  // GPPUA
-		twi_send(0b11000000);  // GPPUB
+		ret = _write(GPPUA, 0b11111111, 0b11000000);
 	#elif MCP23018__DRIVE_COLUMNS
-		twi_send(0b10000000);  // GPPUA
-		twi_send(0b11111111);  // GPPUB
+		ret = _write(GPPUA, 0b10000000, 0b11111111);
 	#endif
-	twi_stop();
+	if (ret) return ret;
 
 	// set logical value (doesn't matter on inputs)
 	// - unused  : hi-Z : 1
 	// - input   : hi-Z : 1
 	// - driving : hi-Z : 1
-	twi_start();
-	ret = twi_send(TWI_ADDR_WRITE);
-	if (ret) goto out;  // make sure we got an ACK
-	twi_send(OLATA);
-	twi_send(0b11111111);  //OLATA
-	twi_send(0b11111111);  //OLATB
-
-out:
-	twi_stop();
-	return ret;
+	return _write(OLATA, 0b11111111, 0b11111111);
 }
 
 /* returns:
  * - success: 0
- * - failure: twi status code
+ * - failure: twi status code, or `TWI_ERROR_*`
+ *
+ * notes:
+ * - after each failure in a row, the next 0, 1, 2, 4, ... (up to
+ *   `BACKOFF_MAX`) scans don't touch the bus at all, and return the same
+ *   error; so an unplugged or misbehaving left hand doesn't cost a timeout
+ *   on every scan.
+ * - meanwhile, our part of the matrix is left as it was last read, so a
+ *   glitch doesn't release (and then press again) every key held on the
+ *   left hand.  it's cleared only once the backoff reaches `BACKOFF_MAX`
+ *   (the left hand has most likely been unplugged).
  */
 #if KB_ROWS != 6 || KB_COLUMNS != 14
 	#error "Expecting different keyboard dimensions"
@@ -112,21 +202,17 @@ out:
 uint8_t mcp23018_update_matrix(bool matrix[KB_ROWS][KB_COLUMNS]) {
 	uint8_t ret, data;
 
+	if (_skip) {
+		_skip--;
+		ret = _error;
+		goto keep;
+	}
+
 	// initialize things, just to make sure
 	// - it's not appreciably faster to skip this, and it takes care of the
 	//   case when the i/o expander isn't plugged in during the first
 	//   init()
-	ret = mcp23018_init();
-
-	// if there was an error
-	if (ret) {
-		// clear our part of the matrix
-		for (uint8_t row=0; row<=5; row++)
-			for (uint8_t col=0; col<=6; col++)
-				matrix[row][col] = 0;
-
-		return ret;
-	}
+	TRY( mcp23018_init() );
 
 
 	// --------------------------------------------------------------------
@@ -136,20 +222,8 @@ uint8_t mcp23018_update_matrix(bool matrix[KB_ROWS][KB_COLUMNS]) {
 		for (uint8_t row=0; row<=5; row++) {
 			// set active row low  : 0
 			// set other rows hi-Z : 1
-			twi_start();
-			twi_send(TWI_ADDR_WRITE);
-			twi_send(GPIOB);
-			twi_send( 0xFF & ~(1<<(5-row)) );
-			twi_stop();
-
 			// read column data
-			twi_start();
-			twi_send(TWI_ADDR_WRITE);
-			twi_send(GPIOA);
-			twi_start();
-			twi_send(TWI_ADDR_READ);
-			twi_read(&data);
-			twi_stop();
+			TRY( _write_read(GPIOB, 0xFF & ~(1<<(5-row)), &data) );
 
 			// update matrix
 			for (uint8_t col=0; col<=6; col++) {
@@ -158,30 +232,14 @@ uint8_t mcp23018_update_matrix(bool matrix[KB_ROWS][KB_COLUMNS]) {
 		}
 
 		// set all rows hi-Z : 1
-		twi_start();
-		twi_send(TWI_ADDR_WRITE);
-		twi_send(GPIOB);
-		twi_send(0xFF);
-		twi_stop();
+		TRY( _write(GPIOB, 0xFF, 0xFF) );  // (GPIOB, then OLATA: no change)
 
 	#elif MCP23018__DRIVE_COLUMNS
 		for (uint8_t col=0; col<=6; col++) {
 			// set active column low  : 0
 			// set other columns hi-Z : 1
-			twi_start();
-			twi_send(TWI_ADDR_WRITE);
-			twi_send(GPIOA);
-			twi_send( 0xFF & ~(1<<col) );
-			twi_stop();
-
 			// read row data
-			twi_start();
-			twi_send(TWI_ADDR_WRITE);
-			twi_send(GPIOB);
-			twi_start();
-			twi_send(TWI_ADDR_READ);
-			twi_read(&data);
-			twi_stop();
+			TRY( _write_read(GPIOA, 0xFF & ~(1<<col), &data) );
 
 			// update matrix
 			for (uint8_t row=0; row<=5; row++) {
@@ -190,17 +248,88 @@ uint8_t mcp23018_update_matrix(bool matrix[KB_ROWS][KB_COLUMNS]) {
 		}
 
 		// set all columns hi-Z : 1
-		twi_start();
-		twi_send(TWI_ADDR_WRITE);
-		twi_send(GPIOA);
-		twi_send(0xFF);
-		twi_stop();
+		TRY( _write(GPIOA, 0xFF, 0xFF) );  // (GPIOA, then GPIOB: inputs)
 
 	#endif
 
 	// /update our part of the matrix
 	// --------------------------------------------------------------------
 
-	return ret;  // success
+	for (uint8_t row=0; row<=5; row++) {
+		_last[row] = 0;
+		for (uint8_t col=0; col<=6; col++)
+			_last[row] |= matrix[row][col] << col;
+	}
+
+	_backoff = _error = 0;
+	return 0;  // success
+
+out:
+	_fail(ret);
+
+keep:
+	// put back our part of the matrix as last read (it may have been half
+	// updated, and `matrix` isn't what was passed last scan anyway); or, if
+	// we've given up, clear it
+	for (uint8_t row=0; row<=5; row++) {
+		if (_backoff == BACKOFF_MAX)
+			_last[row] = 0;
+		for (uint8_t col=0; col<=6; col++)
+			matrix[row][col] = _last[row] & (1<<col);
+	}
+
+	return ret;
 }
 
+/* returns:
+ * - whether any key is pressed, or the left hand has just come back (after
+ *   failing): either way, it's time to scan
+ *
+ * notes:
+ * - drives all the rows (or columns) low at once, the first time after a
+ *   scan (or init), and leaves them so; then just reads all the columns (or
+ *   rows): 1 short transfer per call, instead of a scan's 15.  the next
+ *   scan sets them back (see `mcp23018_init()`).
+ * - a failure counts as nothing pressed (the left hand is left alone for a
+ *   while, as in `mcp23018_update_matrix()`, before being tried again).
+ *   this is called about once a millisecond, so `_skip` (which counts
+ *   scans) is counted down only once every `MAKEFILE_DEBOUNCE_TIME` calls.
+ */
+bool mcp23018_any_pressed(void) {
+	static uint8_t polls;  // since `_skip` was last counted down
+	uint8_t ret, data;
+
+	if (_skip) {
+		if (++polls >= MAKEFILE_DEBOUNCE_TIME) {
+			polls = 0;
+			_skip--;
+		}
+		return false;
+	}
+
+	if (_error) {
+		TRY( mcp23018_init() );
+		_backoff = _error = 0;
+		return true;
+	}
+
+	#if MCP23018__DRIVE_ROWS
+		if (!_low) {
+			TRY( _write(GPIOB, 0b11000000, 0xFF) );  // all rows low
+			_low = true;
+		}
+		TRY( _read(GPIOA, &data) );
+		return (data & 0b01111111) != 0b01111111;
+	#elif MCP23018__DRIVE_COLUMNS
+		if (!_low) {
+			TRY( _write(GPIOA, 0b10000000, 0xFF) );  // all columns low
+			_low = true;
+		}
+		TRY( _read(GPIOB, &data) );
+		return (data & 0b00111111) != 0b00111111;
+	#endif
+
+out:
+	_fail(ret);
+	return false;
+}
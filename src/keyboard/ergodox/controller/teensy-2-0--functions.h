@@ -18,6 +18,7 @@
 
 	uint8_t teensy_init(void);
 	uint8_t teensy_update_matrix( bool matrix[KB_ROWS][KB_COLUMNS] );
+	bool    teensy_any_pressed(void);
 
 #endif
 
@@ -0,0 +1,176 @@
+/* ----------------------------------------------------------------------------
+ * ergoDOX : controller : Teensy 2.0 specific code : LED control
+ *
+ * - Timer/Counter1 runs the PWM on OC1(A|B|C) (see "PWM on ports OC1(A|B|C)"
+ *   in "teensy-2-0.md"), at clock / 64 / 256 (about 1 kHz); and its overflow
+ *   interrupt moves each LED a step towards its target brightness, about
+ *   once a millisecond.
+ * - Brightness is perceived brightness (0..255), turned into a duty cycle
+ *   through `_gamma`: so a fade looks even, and half looks like half.
+ * - Nothing else here waits for, or works on, the LEDs: the functions below
+ *   only post a new target.  Once every LED has reached its target (and none
+ *   are breathing, other than at brightness 0), the interrupt turns itself
+ *   off.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include "./teensy-2-0--led.h"
+
+// ----------------------------------------------------------------------------
+
+#define LEDS  3
+
+// steps of brightness per interrupt: a full fade takes about 255 / this
+// milliseconds
+#define FADE_STEP  4
+
+// interrupts per step, while breathing: a full breath (in and out) takes
+// about 2 * 255 * this milliseconds
+#define BREATHE_DIVIDER  6
+
+// duty cycle (0..255) for each perceived brightness (0..255): 255 * (n /
+// 255) ^ 2.2, but at least 1 (so that any brightness above 0 is visible)
+static const uint8_t PROGMEM _gamma[256] = {
+	  0,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+	  1,  1,  1,  1,  1,  1,  1,  1,  1,  2,  2,  2,  2,  2,  2,  2,
+	  3,  3,  3,  3,  3,  4,  4,  4,  4,  5,  5,  5,  5,  6,  6,  6,
+	  6,  7,  7,  7,  8,  8,  8,  9,  9,  9, 10, 10, 11, 11, 11, 12,
+	 12, 13, 13, 13, 14, 14, 15, 15, 16, 16, 17, 17, 18, 18, 19, 19,
+	 20, 20, 21, 22, 22, 23, 23, 24, 25, 25, 26, 26, 27, 28, 28, 29,
+	 30, 30, 31, 32, 33, 33, 34, 35, 35, 36, 37, 38, 39, 39, 40, 41,
+	 42, 43, 43, 44, 45, 46, 47, 48, 49, 49, 50, 51, 52, 53, 54, 55,
+	 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71,
+	 73, 74, 75, 76, 77, 78, 79, 81, 82, 83, 84, 85, 87, 88, 89, 90,
+	 91, 93, 94, 95, 97, 98, 99,100,102,103,105,106,107,109,110,111,
+	113,114,116,117,119,120,121,123,124,126,127,129,130,132,133,135,
+	137,138,140,141,143,145,146,148,149,151,153,154,156,158,159,161,
+	163,165,166,168,170,172,173,175,177,179,181,182,184,186,188,190,
+	192,194,196,197,199,201,203,205,207,209,211,213,215,217,219,221,
+	223,225,227,229,231,234,236,238,240,242,244,246,248,251,253,255,
+};
+
+static volatile struct {
+	uint8_t brightness;  // when on
+	uint8_t level;       // now
+	uint8_t target;
+	bool    breathing;   // (between 0 and `brightness`)
+} _leds[LEDS];
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Make sure the interrupt is on (since there's something to do)
+ */
+static void _wake(void) {
+	TIFR1  = (1<<TOV1);   // (clear a stale overflow)
+	TIMSK1 |= (1<<TOIE1);
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Set up Timer/Counter1, and turn all the LEDs off
+ *
+ * Note
+ * - The interrupt does nothing until interrupts are enabled (see
+ *   "lib/timer").
+ */
+void _kb_led_init(void) {
+	DDRB &= ~( (1<<5)|(1<<6)|(1<<7) );  // hi-Z (off)
+	OCR1A = OCR1B = OCR1C = 0;
+
+	TCCR1A = 0b10101001;  // set and configure fast PWM (8-bit)
+	TCCR1B = 0b00001011;  // set and configure fast PWM (clock / 64)
+}
+
+/*
+ * Set the given LED's brightness, when on (0..255)
+ */
+void _kb_led_set(uint8_t led, uint8_t brightness) {
+	_leds[led].brightness = brightness;
+	if (_leds[led].target)
+		_leds[led].target = brightness;
+	_wake();
+}
+
+void _kb_led_on(uint8_t led) {
+	_leds[led].breathing = false;
+	_leds[led].target = _leds[led].brightness;
+	_wake();
+}
+
+void _kb_led_off(uint8_t led) {
+	_leds[led].breathing = false;
+	_leds[led].target = 0;
+	_wake();
+}
+
+/*
+ * Fade the given LED in and out, until it's turned on or off
+ */
+void _kb_led_breathe(uint8_t led) {
+	_leds[led].breathing = true;
+	_wake();
+}
+
+// ----------------------------------------------------------------------------
+
+ISR(TIMER1_OVF_vect) {
+	static uint8_t ticks;
+	bool busy = false;
+
+	ticks = (ticks + 1) % BREATHE_DIVIDER;
+
+	for (uint8_t led=0; led<LEDS; led++) {
+		uint8_t level  = _leds[led].level;
+		uint8_t target = _leds[led].target;
+		uint8_t step   = FADE_STEP;
+
+		if (_leds[led].breathing) {
+			// (breathing between 0 and 0: nothing to do, once out)
+			if (!_leds[led].brightness && !level && !target)
+				continue;
+			busy = true;
+			if (ticks)
+				continue;
+			step = 1;
+			if (level == target)  // (turn around)
+				target = _leds[led].target =
+					level ? 0 : _leds[led].brightness;
+		}
+
+		if (level == target)
+			continue;
+		busy = true;
+
+		if (level < target)
+			level = (target - level > step) ? level + step : target;
+		else
+			level = (level - target > step) ? level - step : target;
+		_leds[led].level = level;
+
+		uint8_t duty = pgm_read_byte(&_gamma[level]);
+		switch (led) {
+			case 0: OCR1A = duty; break;
+			case 1: OCR1B = duty; break;
+			case 2: OCR1C = duty; break;
+		}
+		// (hi-Z when off: fast PWM still pulses, for a cycle, at 0)
+		if (duty)
+			DDRB |=  (1<<(5+led));
+		else
+			DDRB &= ~(1<<(5+led));
+	}
+
+	if (!busy)
+		TIMSK1 &= ~(1<<TOIE1);
+}
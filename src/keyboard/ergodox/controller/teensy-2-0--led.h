@@ -11,24 +11,36 @@
 	#define KEYBOARD__ERGODOX__CONTROLLER__TEENSY_2_0__LED_h
 
 	#include <stdint.h>
-	#include <avr/io.h>  // for the register macros
 
 	// --------------------------------------------------------------------
 
-	#define _kb_led_1_on()           (DDRB |=  (1<<5))
-	#define _kb_led_1_off()          (DDRB &= ~(1<<5))
-	#define _kb_led_1_set(n)         (OCR1A = (uint8_t)(n))
-	#define _kb_led_1_set_percent(n) (OCR1A = (uint8_t)((n) * 0xFF))
+	// brightness is perceived brightness, 0..255 (see "teensy-2-0--led.c");
+	// on, off, and breathe fade, and return at once
+	void _kb_led_init    (void);
+	void _kb_led_set     (uint8_t led, uint8_t brightness);
+	void _kb_led_on      (uint8_t led);
+	void _kb_led_off     (uint8_t led);
+	void _kb_led_breathe (uint8_t led);
 
-	#define _kb_led_2_on()           (DDRB |=  (1<<6))
-	#define _kb_led_2_off()          (DDRB &= ~(1<<6))
-	#define _kb_led_2_set(n)         (OCR1B = (uint8_t)(n))
-	#define _kb_led_2_set_percent(n) (OCR1B = (uint8_t)((n) * 0xFF))
+	// --------------------------------------------------------------------
+
+	#define _kb_led_1_on()           _kb_led_on(0)
+	#define _kb_led_1_off()          _kb_led_off(0)
+	#define _kb_led_1_breathe()      _kb_led_breathe(0)
+	#define _kb_led_1_set(n)         _kb_led_set(0, (uint8_t)(n))
+	#define _kb_led_1_set_percent(n) _kb_led_set(0, (uint8_t)((n) * 0xFF))
+
+	#define _kb_led_2_on()           _kb_led_on(1)
+	#define _kb_led_2_off()          _kb_led_off(1)
+	#define _kb_led_2_breathe()      _kb_led_breathe(1)
+	#define _kb_led_2_set(n)         _kb_led_set(1, (uint8_t)(n))
+	#define _kb_led_2_set_percent(n) _kb_led_set(1, (uint8_t)((n) * 0xFF))
 
-	#define _kb_led_3_on()           (DDRB |=  (1<<7))
-	#define _kb_led_3_off()          (DDRB &= ~(1<<7))
-	#define _kb_led_3_set(n)         (OCR1C = (uint8_t)(n))
-	#define _kb_led_3_set_percent(n) (OCR1C = (uint8_t)((n) * 0xFF))
+	#define _kb_led_3_on()           _kb_led_on(2)
+	#define _kb_led_3_off()          _kb_led_off(2)
+	#define _kb_led_3_breathe()      _kb_led_breathe(2)
+	#define _kb_led_3_set(n)         _kb_led_set(2, (uint8_t)(n))
+	#define _kb_led_3_set_percent(n) _kb_led_set(2, (uint8_t)((n) * 0xFF))
 
 
 	#define _kb_led_all_on() do {	\
@@ -43,6 +55,12 @@
 		_kb_led_3_off();	\
 		} while(0)
 
+	#define _kb_led_all_breathe() do {	\
+		_kb_led_1_breathe();		\
+		_kb_led_2_breathe();		\
+		_kb_led_3_breathe();		\
+		} while(0)
+
 	#define _kb_led_all_set(n) do {	\
 		_kb_led_1_set(n);	\
 		_kb_led_2_set(n);	\
@@ -180,9 +180,7 @@ uint8_t teensy_init(void) {
 	PORTB &= ~(1<<4);  // set B(4) internal pull-up disabled
 
 	// keyboard LEDs (see "PWM on ports OC1(A|B|C)" in "teensy-2-0.md")
-	_kb_led_all_off();  // (just to put the pins in a known state)
-	TCCR1A  = 0b10101001;  // set and configure fast PWM
-	TCCR1B  = 0b00001001;  // set and configure fast PWM
+	_kb_led_init();  // (see "teensy-2-0--led.c")
 
 	// I2C (TWI)
 	twi_init();  // on pins D(1,0)
@@ -232,3 +230,31 @@ uint8_t teensy_update_matrix(bool matrix[KB_ROWS][KB_COLUMNS]) {
 
 	return 0;  // success
 }
+
+/* returns
+ * - whether any key is pressed
+ *
+ * notes
+ * - drives all the rows (or columns) low at once, and reads all the columns
+ *   (or rows) once: much quicker than a scan.
+ */
+bool teensy_any_pressed(void) {
+	bool pressed;
+
+	#if TEENSY__DRIVE_ROWS
+		teensypin_write_all_row(DDR, SET);  // all low (set as output)
+		pressed = ! teensypin_read(COLUMN_7) || ! teensypin_read(COLUMN_8)
+		       || ! teensypin_read(COLUMN_9) || ! teensypin_read(COLUMN_A)
+		       || ! teensypin_read(COLUMN_B) || ! teensypin_read(COLUMN_C)
+		       || ! teensypin_read(COLUMN_D);
+		teensypin_write_all_row(DDR, CLEAR);  // all hi-Z (set as input)
+	#elif TEENSY__DRIVE_COLUMNS
+		teensypin_write_all_column(DDR, SET);  // all low (set as output)
+		pressed = ! teensypin_read(ROW_0) || ! teensypin_read(ROW_1)
+		       || ! teensypin_read(ROW_2) || ! teensypin_read(ROW_3)
+		       || ! teensypin_read(ROW_4) || ! teensypin_read(ROW_5);
+		teensypin_write_all_column(DDR, CLEAR);  // all hi-Z (set as input)
+	#endif
+
+	return pressed;
+}
@@ -23,15 +23,17 @@
 			} while(0)
 	#endif
 
-	// note: need to delay for a total of ~1 second
-	#ifndef kb_led_delay_usb_init
-	#define kb_led_delay_usb_init() do {				\
-			_kb_led_1_set_percent(MAKEFILE_LED_BRIGHTNESS);	\
-			_delay_ms(333);					\
-			_kb_led_2_set_percent(MAKEFILE_LED_BRIGHTNESS);	\
-			_delay_ms(333);					\
-			_kb_led_3_set_percent(MAKEFILE_LED_BRIGHTNESS);	\
-			_delay_ms(333);					\
+	// note: called with steps 0, 1, and 2, about 333 ms apart, once the
+	// host has configured the keyboard; `kb_led_state_ready()` is called
+	// about 333 ms after the last (see `MAIN_BOOT_SETTLE` in "main.c").
+	// must return at once (the keyboard is scanned meanwhile).
+	#ifndef kb_led_usb_init_step
+	#define kb_led_usb_init_step(step) do {				\
+			switch (step) {					\
+			case 0: _kb_led_1_set_percent(MAKEFILE_LED_BRIGHTNESS); break; \
+			case 1: _kb_led_2_set_percent(MAKEFILE_LED_BRIGHTNESS); break; \
+			case 2: _kb_led_3_set_percent(MAKEFILE_LED_BRIGHTNESS); break; \
+			}						\
 			} while(0)
 	#endif
 
@@ -82,5 +84,74 @@
 	#endif
 
 
+	/*
+	 * event macros
+	 * - called by `main()` only when something changes, so nothing is done
+	 *   (and, if a macro is empty, nothing is compiled in) in the steady
+	 *   state
+	 *
+	 * kb_led_host_changed(leds)
+	 * - called when the LED report from the host changes (and once at
+	 *   startup)
+	 * - 'leds': the new report (bit 0 = num lock, 1 = caps lock, 2 = scroll
+	 *   lock, 3 = compose, 4 = kana)
+	 *
+	 * kb_led_layer_changed(layer)
+	 * - called when the layer stack changes (and once at startup)
+	 * - 'layer': the layer-number now on top of the stack
+	 * - with `KB_LED_LAYER_LED` defined (1, 2, or 3) by the layout specific
+	 *   '.h', the default shows the layer on that LED: off for layer 0,
+	 *   and brighter for each layer above it, in `KB_LED_LAYER_LEVELS`
+	 *   steps of perceived brightness (the last, and any layer above it, at
+	 *   `MAKEFILE_LED_BRIGHTNESS`).  The layout should then `#define
+	 *   kb_led_scroll_on()` (etc.) to nothing, if that LED was being used
+	 *   for it.
+	 * - otherwise, the default does nothing; a layout may define its own
+	 *   (e.g. with `_kb_led_3_breathe()`, to fade LED 3 in and out)
+	 *
+	 * - all of these only post a change: the LEDs fade to it on their own
+	 *   (see "controller/teensy-2-0--led.c")
+	 */
+
+	#ifndef kb_led_host_changed
+	#define kb_led_host_changed(leds) do {				\
+			if ((leds) & (1<<0)) { kb_led_num_on(); }	\
+			else { kb_led_num_off(); }			\
+			if ((leds) & (1<<1)) { kb_led_caps_on(); }	\
+			else { kb_led_caps_off(); }			\
+			if ((leds) & (1<<2)) { kb_led_scroll_on(); }	\
+			else { kb_led_scroll_off(); }			\
+			if ((leds) & (1<<3)) { kb_led_compose_on(); }	\
+			else { kb_led_compose_off(); }			\
+			if ((leds) & (1<<4)) { kb_led_kana_on(); }	\
+			else { kb_led_kana_off(); }			\
+			} while(0)
+	#endif
+
+	#ifndef KB_LED_LAYER_LEVELS
+	#define KB_LED_LAYER_LEVELS  4
+	#endif
+
+	#ifndef kb_led_layer_changed
+	#ifdef KB_LED_LAYER_LED
+	#define kb_led_layer_changed(layer) do {			\
+			uint8_t level = ( (layer) < KB_LED_LAYER_LEVELS	\
+			                  ? (layer) : KB_LED_LAYER_LEVELS ); \
+			if (level) {					\
+				_kb_led_set( KB_LED_LAYER_LED-1,	\
+				             (uint16_t)level		\
+				             * (uint8_t)(MAKEFILE_LED_BRIGHTNESS * 0xFF) \
+				             / KB_LED_LAYER_LEVELS );	\
+				_kb_led_on(KB_LED_LAYER_LED-1);		\
+			} else {					\
+				_kb_led_off(KB_LED_LAYER_LED-1);	\
+			}						\
+			} while(0)
+	#else
+	#define kb_led_layer_changed(layer)
+	#endif
+	#endif
+
+
 #endif
 
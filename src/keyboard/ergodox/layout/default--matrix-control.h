@@ -18,8 +18,22 @@
 
 	// --------------------------------------------------------------------
 
+	/*
+	 * KB_LAYERS
+	 * - The maximum number of layers a layout may define (not the number it
+	 *   does define: the matrices are sized by the layers actually given,
+	 *   so unused layers cost no Flash).
+	 * - Must be 32 or less (so that a layer number always fits
+	 *   in 5 bits).
+	 * - Layouts with 8 or fewer layers may set this to 8 in their '.h', to
+	 *   halve the SRAM used to remember which layer each key was pressed on
+	 *   (see `main_layers_pressed` in "main.h").
+	 */
 	#ifndef KB_LAYERS
-		#define KB_LAYERS 10
+		#define KB_LAYERS 32
+	#endif
+	#if KB_LAYERS > 32
+		#error "KB_LAYERS must be 32 or less"
 	#endif
 
 	// --------------------------------------------------------------------
@@ -44,11 +58,17 @@
 	 * - To override these macros with real functions, set the macro equal
 	 *   to itself (e.g. `#define kb_layout_get kb_layout_get`) and provide
 	 *   function prototypes, in the layout specific '.h'
+	 *
+	 * - The matrices are declared without a layer dimension; layouts define
+	 *   only the layers they use, and must then export how many that is
+	 *   with `KB_LAYOUT_LAYERS_DEFINE()` (see below).  Layer numbers are
+	 *   checked against this once, when they are pushed, so lookups stay a
+	 *   plain index.
 	 */
 
 	#ifndef kb_layout_get
 		extern const uint8_t PROGMEM \
-			       _kb_layout[KB_LAYERS][KB_ROWS][KB_COLUMNS];
+			       _kb_layout[][KB_ROWS][KB_COLUMNS];
 
 		#define kb_layout_get(layer,row,column) \
 			( (uint8_t) \
@@ -58,7 +78,7 @@
 
 	#ifndef kb_layout_press_get
 		extern const void_funptr_t PROGMEM \
-			_kb_layout_press[KB_LAYERS][KB_ROWS][KB_COLUMNS];
+			_kb_layout_press[][KB_ROWS][KB_COLUMNS];
 
 		#define kb_layout_press_get(layer,row,column) \
 			( (void_funptr_t) \
@@ -68,7 +88,7 @@
 
 	#ifndef kb_layout_release_get
 		extern const void_funptr_t PROGMEM \
-			_kb_layout_release[KB_LAYERS][KB_ROWS][KB_COLUMNS];
+			_kb_layout_release[][KB_ROWS][KB_COLUMNS];
 
 		#define kb_layout_release_get(layer,row,column) \
 			( (void_funptr_t) \
@@ -77,5 +97,363 @@
 
 	#endif
 
+	#ifndef kb_layout_layers_get
+		extern const uint8_t PROGMEM _kb_layout_layers;
+
+		#define kb_layout_layers_get() \
+			( (uint8_t) \
+			  pgm_read_byte(&( \
+				_kb_layout_layers )) )
+
+		// to be used once, in the layout '.c', after the matrices
+		// - the layer count is taken from `_kb_layout`; the press and
+		//   release matrices may define extra (unreachable) layers
+		#define _KB_LAYOUT_LAYERS_OF(matrix) \
+			( sizeof(matrix) / sizeof((matrix)[0]) )
+		#define KB_LAYOUT_LAYERS_DEFINE() \
+			_Static_assert( \
+				_KB_LAYOUT_LAYERS_OF(_kb_layout) <= KB_LAYERS \
+				&& _KB_LAYOUT_LAYERS_OF(_kb_layout_press) \
+				   >= _KB_LAYOUT_LAYERS_OF(_kb_layout) \
+				&& _KB_LAYOUT_LAYERS_OF(_kb_layout_release) \
+				   >= _KB_LAYOUT_LAYERS_OF(_kb_layout), \
+				"the press and release matrices must define every " \
+				"layer in `_kb_layout` (which may define no more " \
+				"than KB_LAYERS)" ); \
+			const uint8_t PROGMEM _kb_layout_layers = \
+				_KB_LAYOUT_LAYERS_OF(_kb_layout)
+	#endif
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * macros
+	 *
+	 * Layouts using `kbfun_macro_play` define a table of (pointers to)
+	 * macro programs (see "lib/key-functions/private.h"), and give the
+	 * index of the one to play in place of the key's keycode.
+	 *
+	 * - Layouts that don't use it needn't define the table: the function,
+	 *   and its reference to the table, are discarded at link time.
+	 */
+
+	#ifndef kb_layout_macro_get
+		extern const uint8_t * const PROGMEM _kb_layout_macros[];
+
+		#define kb_layout_macro_get(index) \
+			( (const uint8_t *) \
+			  pgm_read_word(&( \
+				_kb_layout_macros[index] )) )
+	#endif
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * unicode characters
+	 *
+	 * Layouts using `kbfun_unicode` define a table of code points, and give
+	 * the index of the one to type in place of the key's keycode.  How it's
+	 * typed depends on the host's input method (see
+	 * "lib/key-functions/unicode.c"); `KB_UNICODE_MODE` is the one used
+	 * until another is chosen (with `kbfun_unicode_mode_next`, which saves
+	 * the choice to the EEPROM).
+	 *
+	 * - Layouts that don't use it needn't define the table.
+	 */
+
+	#ifndef KB_UNICODE_MODE
+		#define KB_UNICODE_MODE  UNICODE_MODE_LINUX
+	#endif
+
+	#ifndef kb_layout_unicode_get
+		extern const uint32_t PROGMEM _kb_layout_unicode[];
+
+		#define kb_layout_unicode_get(index) \
+			( (uint32_t) \
+			  pgm_read_dword(&( \
+				_kb_layout_unicode[index] )) )
+	#endif
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * tap-hold keys
+	 *
+	 * Layouts using `kbfun_tap_hold` define a table of what each such key
+	 * does when tapped and when held (see `KB_TAP_HOLD_KEY()` and
+	 * `KB_TAP_HOLD_LAYER()`), and give the index of the entry in place of
+	 * the key's keycode.
+	 *
+	 * - The flags choose how early a key decides it's being held (see
+	 *   "lib/key-functions/tap-hold.c").  With none, it's held only once
+	 *   it's been down for `KB_TAPPING_TERM` milliseconds.
+	 *
+	 * - Layouts that don't use it needn't define the table.
+	 */
+
+	#ifndef KB_TAPPING_TERM
+		#define KB_TAPPING_TERM  200  // in milliseconds
+	#endif
+
+	// hold: push a layer (else: press a keycode)
+	#define KB_TAP_HOLD_FLAG_LAYER         (1<<0)
+	// hold, if another key is pressed and released while this one is down
+	#define KB_TAP_HOLD_FLAG_PERMISSIVE    (1<<1)
+	// hold, as soon as another key is pressed while this one is down
+	#define KB_TAP_HOLD_FLAG_ON_OTHER_KEY  (1<<2)
+
+	// table entries
+	#define KB_TAP_HOLD_KEY(tap_keycode, hold_keycode, flags) \
+		{ (tap_keycode), (hold_keycode), (flags) }
+	#define KB_TAP_HOLD_LAYER(tap_keycode, hold_layer, flags) \
+		{ (tap_keycode), (hold_layer), (flags) | KB_TAP_HOLD_FLAG_LAYER }
+
+	#define KB_TAP_HOLD_TAP    0  // (fields of an entry)
+	#define KB_TAP_HOLD_HOLD   1
+	#define KB_TAP_HOLD_FLAGS  2
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * one-shot modifiers, and sticky layers
+	 *
+	 * A one-shot modifier (`kbfun_one_shot`), or a sticky layer
+	 * (`kbfun_layer_sticky_*`), tapped and then left alone, is let go of
+	 * after `KB_ONE_SHOT_TIMEOUT` milliseconds (0 for never).  Tapped twice
+	 * within `KB_TAPPING_TERM`, it's locked instead.
+	 */
+
+	#ifndef KB_ONE_SHOT_TIMEOUT
+		#define KB_ONE_SHOT_TIMEOUT  3000  // in milliseconds
+	#endif
+
+	#ifndef kb_layout_tap_hold_get
+		extern const uint8_t PROGMEM _kb_layout_tap_holds[][3];
+
+		#define kb_layout_tap_hold_get(index,field) \
+			( (uint8_t) \
+			  pgm_read_byte(&( \
+				_kb_layout_tap_holds[index][field] )) )
+	#endif
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * tap-dance keys
+	 *
+	 * Layouts using `kbfun_tap_dance` define a table of what each such key
+	 * does when tapped once, twice, or three times (each tap within
+	 * `KB_TAPPING_TERM` milliseconds of the last), when held, and when
+	 * tapped and then held (see `KB_TAP_DANCE()`), and give the index of
+	 * the entry in place of the key's keycode.
+	 *
+	 * - Any of the keycodes may be 0, for nothing.  The fewer there are,
+	 *   the sooner the key can decide (see "lib/key-functions/tap-dance.c").
+	 *
+	 * - Layouts that don't use it needn't define the table.
+	 */
+
+	#define KB_TAP_DANCE(tap_1, tap_2, tap_3, hold, tap_hold) \
+		{ (tap_1), (tap_2), (tap_3), (hold), (tap_hold) }
+
+	#define KB_TAP_DANCE_TAP_1     0  // (fields of an entry)
+	#define KB_TAP_DANCE_TAP_2     1
+	#define KB_TAP_DANCE_TAP_3     2
+	#define KB_TAP_DANCE_HOLD      3
+	#define KB_TAP_DANCE_TAP_HOLD  4
+
+	#ifndef kb_layout_tap_dance_get
+		extern const uint8_t PROGMEM _kb_layout_tap_dances[][5];
+
+		#define kb_layout_tap_dance_get(index,field) \
+			( (uint8_t) \
+			  pgm_read_byte(&( \
+				_kb_layout_tap_dances[index][field] )) )
+	#endif
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * combos
+	 *
+	 * Keys pressed together (each within `KB_COMBO_TERM` milliseconds of
+	 * the first) may send a keycode of their own instead (e.g. two home row
+	 * keys for Escape), whatever layer is active.
+	 *
+	 * - `_kb_layout_combo_keys` has bit `n` set for every key in combo `n`
+	 *   (so whether a key might be part of a combo is a single lookup), and
+	 *   may be written with `KB_MATRIX_LAYER()`.  `_kb_layout_combos` gives
+	 *   each combo's keycode, and how many keys it has.
+	 *
+	 * - At most 8 combos, of 2 to `KB_COMBO_KEYS_MAX` keys each.
+	 *
+	 * - Layouts with combos `#define KB_LAYOUT_HAS_COMBOS` in their '.h'.
+	 *   Without, the lookups (and the combo code, see
+	 *   "lib/key-functions/combo.c") compile out.
+	 */
+
+	#ifndef KB_COMBO_TERM
+		#define KB_COMBO_TERM  50  // in milliseconds
+	#endif
+
+	#define KB_COMBO_KEYS_MAX  4
+
+	#define KB_COMBO_KEYCODE  0  // (fields of an entry)
+	#define KB_COMBO_KEYS     1
+
+	#ifndef kb_layout_combo_keys_get
+		#ifdef KB_LAYOUT_HAS_COMBOS
+			extern const uint8_t PROGMEM \
+				_kb_layout_combo_keys[KB_ROWS][KB_COLUMNS];
+			extern const uint8_t PROGMEM _kb_layout_combos[][2];
+
+			#define kb_layout_combo_keys_get(row,column) \
+				( (uint8_t) \
+				  pgm_read_byte(&( \
+					_kb_layout_combo_keys[row][column] )) )
+			#define kb_layout_combo_get(index,field) \
+				( (uint8_t) \
+				  pgm_read_byte(&( \
+					_kb_layout_combos[index][field] )) )
+		#else
+			#define kb_layout_combo_keys_get(row,column) \
+				( (uint8_t) 0 )
+			#define kb_layout_combo_get(index,field) \
+				( (uint8_t) 0 )
+		#endif
+	#endif
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * leader key
+	 *
+	 * After `kbfun_leader`, the keys typed are looked up one at a time in
+	 * a trie, and the macro at the end of the sequence is played (see
+	 * "lib/key-functions/leader.c").
+	 *
+	 * - `_kb_layout_leader` is the trie: a list of nodes, the root first.
+	 *   Each node is
+	 *   - the index of the macro to play (see `_kb_layout_macros`) plus 1,
+	 *     or 0 for none
+	 *   - the number of children, then for each child
+	 *     - the keycode leading to it
+	 *     - its offset (in bytes) from the start of the trie
+	 *   So each key typed is a lookup among the current node's children
+	 *   only, and the trie may be at most 256 bytes.
+	 *
+	 * - If a node has both a macro and children, the macro is played when
+	 *   the next key typed isn't one of them, or after `KB_LEADER_TIMEOUT`
+	 *   milliseconds without a key.  Otherwise nothing waits: a leaf plays
+	 *   at once, and a key that leads nowhere ends the sequence at once.
+	 *
+	 * - Layouts with a trie `#define KB_LAYOUT_HAS_LEADER` in their '.h'.
+	 *   Without, the leader code compiles out.
+	 */
+
+	#ifndef KB_LEADER_TIMEOUT
+		#define KB_LEADER_TIMEOUT  1000  // in milliseconds
+	#endif
+
+	#ifndef kb_layout_leader_get
+		extern const uint8_t PROGMEM _kb_layout_leader[];
+
+		#define kb_layout_leader_get(offset) \
+			( (uint8_t) \
+			  pgm_read_byte(&( \
+				_kb_layout_leader[offset] )) )
+	#endif
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * keymaps
+	 *
+	 * A generated layout may link several keymaps into one image (see
+	 * `KEYMAPS` in "makefile-options").  Their layers are deduplicated and
+	 * stored together in the matrices above; each keymap then has a table
+	 * mapping its own layer numbers to layers in the matrices.
+	 *
+	 * - Layer numbers are translated once, when they're pushed (see
+	 *   `main_layers_push()`), so the layer stack (and everything that
+	 *   looks at the matrices) only ever sees matrix layers, and the
+	 *   per-key lookups stay a plain index.
+	 *
+	 * - Switching keymaps is a matter of pointing `main_keymap_layers` at
+	 *   another table (see `main_keymap_select()`).
+	 *
+	 * - With only one keymap, the translation is the identity, and compiles
+	 *   out.
+	 */
+
+	#ifndef KB_KEYMAPS
+		#define KB_KEYMAPS 1
+	#endif
+
+	#if KB_KEYMAPS > 1
+		// defined by the (generated) layout '.c'
+		// - `KB_KEYMAP_LAYERS` (the width of the table) is defined by the
+		//   (generated) layout '.h'
+		extern const uint8_t PROGMEM \
+			_kb_keymap_layers[KB_KEYMAPS][KB_KEYMAP_LAYERS];
+		extern const uint8_t PROGMEM \
+			_kb_keymap_layer_counts[KB_KEYMAPS];
+
+		// defined in "main.c"
+		extern const uint8_t * main_keymap_layers;
+		extern uint8_t         main_keymap_layer_count;
+
+		#define kb_keymap_layers_get() \
+			( main_keymap_layer_count )
+		#define kb_keymap_layer_get(layer) \
+			( (uint8_t) \
+			  pgm_read_byte(&( \
+				main_keymap_layers[layer] )) )
+	#else
+		#define kb_keymap_layers_get() \
+			( kb_layout_layers_get() )
+		#define kb_keymap_layer_get(layer) \
+			( (uint8_t) (layer) )
+	#endif
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * per-key flags
+	 *
+	 * Precomputed (by "build-scripts/gen-layout-source.py") facts about a
+	 * key's mapping across all layers, so that the main loop can skip work
+	 * for keys that don't need it.
+	 *
+	 * - Hand written layouts have no flags (every key gets the full
+	 *   treatment), and the lookups compile out.
+	 *
+	 * - Generated layouts `#define KB_LAYOUT_HAS_KEY_FLAGS` in their '.h',
+	 *   and define `_kb_layout_key_flags` in their '.c'.
+	 */
+
+	// transparent (press and release) on every layer above layer 0 (on
+	// every layer but the keymaps' base layers, if there are several): the
+	// key will always resolve to the base layer, so there's no need to walk
+	// the stack
+	#define KB_LAYOUT_KEY_FLAG_TRANSPARENT_ABOVE_0  (1<<0)
+	// identical on every layer: the layer stack needn't be consulted at all
+	#define KB_LAYOUT_KEY_FLAG_STATIC               (1<<1)
+
+	#ifndef kb_layout_key_flags_get
+		#ifdef KB_LAYOUT_HAS_KEY_FLAGS
+			extern const uint8_t PROGMEM \
+				_kb_layout_key_flags[KB_ROWS][KB_COLUMNS];
+
+			#define kb_layout_key_flags_get(row,column) \
+				( (uint8_t) \
+				  pgm_read_byte(&( \
+					_kb_layout_key_flags[row][column] )) )
+		#else
+			#define kb_layout_key_flags_get(row,column) \
+				( (uint8_t) 0 )
+		#endif
+	#endif
+
 #endif
 
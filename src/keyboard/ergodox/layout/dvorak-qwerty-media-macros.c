@@ -11,22 +11,9 @@
 #include "../../../lib/data-types/misc.h"
 #include "../../../lib/usb/usage-page/keyboard--short-names.h"
 #include "../../../lib/key-functions/public.h"
+#include "../../../lib/key-functions/private.h"
 #include "../matrix.h"
 #include "../layout.h"
-// FUNCTIONS ------------------------------------------------------------------
-void kbfun_layer_pop_all(void) {
-  kbfun_layer_pop_1();
-  kbfun_layer_pop_2();
-  kbfun_layer_pop_3();
-  kbfun_layer_pop_4();
-  kbfun_layer_pop_5();
-  kbfun_layer_pop_6();
-  kbfun_layer_pop_7();
-  kbfun_layer_pop_8();
-  kbfun_layer_pop_9();
-  kbfun_layer_pop_10();
-}
-
 // DEFINITIONS ----------------------------------------------------------------
 #define  kprrel   &kbfun_press_release
 #define  mprrel   &kbfun_mediakey_press_release
@@ -61,22 +48,12 @@ void kbfun_layer_pop_all(void) {
 #define  slpunum  &kbfun_layer_push_numpad
 #define  slponum  &kbfun_layer_pop_numpad
 
-#define  warrow   &kbfun_arrow_write
-#define  wpdq     &kbfun_parenthesis_double_quote_write
-#define  wdqp     &kbfun_double_quote_parenthesis_write
-#define  wlt2dq   &kbfun_lt2_double_quote_write
-#define  wdqgt2   &kbfun_double_quote_gt2_write
-
-
-#define vsave     &kbfun_vim_save
-#define vsaveq    &kbfun_vim_save_and_quit
-#define vbuff     &kbfun_vim_buffers
-
+#define  mplay    &kbfun_macro_play
 
 // ----------------------------------------------------------------------------
  
 // LAYOUT ---------------------------------------------------------------------
-const uint8_t PROGMEM _kb_layout[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
+const uint8_t PROGMEM _kb_layout[][KB_ROWS][KB_COLUMNS] = {
 // LAYER 0
 KB_MATRIX_LAYER(
   // unused
@@ -152,9 +129,9 @@ KB_MATRIX_LAYER(
   0,  
   // left hand
   0,  0,  0,  0,  0,  0,  0,  
-  0,  'm',  'm',  'm',  'm',  'm',  0,  
+  0,  3,  1,  0,  2,  4,  0,  
   0,  KEY_a_A,  KEY_o_O,  KEY_e_E,  KEY_u_U,  KEY_i_I,  
-  0,  0,  'm',  0,  0,  0,  0,  
+  0,  0,  6,  0,  0,  0,  0,  
   0,  0,  0,  0,  0,  
   0,  0,  
   0,  0,  0,  
@@ -163,7 +140,7 @@ KB_MATRIX_LAYER(
   0,  0,  0,  0,  0,  0,  0,  
   0,  KEY_6_Caret,  KEY_4_Dollar, KEY_Backslash_Pipe, KEY_Semicolon_Colon,  KEY_SingleQuote_DoubleQuote,  0,  
   0,  0,  0,  KEY_n_N,  0,  0,  
-  0,  'm',  0,  'm',  0,  0,  0,  
+  0,  7,  0,  5,  0,  0,  0,  
   0,  0,  0,  0,  0,  
   0,  0,  
   0,  0,  0,  
@@ -173,7 +150,7 @@ KB_MATRIX_LAYER(
 // ----------------------------------------------------------------------------
 
 // PRESS ----------------------------------------------------------------------
-const void_funptr_t PROGMEM _kb_layout_press[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
+const void_funptr_t PROGMEM _kb_layout_press[][KB_ROWS][KB_COLUMNS] = {
 // LAYER 0
 KB_MATRIX_LAYER(
   // unused
@@ -249,9 +226,9 @@ KB_MATRIX_LAYER(
   NULL, 
   // left hand
   NULL, NULL, NULL, NULL, NULL, NULL, NULL, 
-  NULL, wlt2dq, wpdq, warrow, wdqp, wdqgt2, NULL, 
+  NULL, mplay, mplay, mplay, mplay, mplay, NULL, 
   NULL, saeprre, saeprre, saeprre, saeprre, saeprre,
-  ktrans, NULL, vsaveq, NULL, NULL, NULL, NULL, 
+  ktrans, NULL, mplay, NULL, NULL, NULL, NULL, 
   NULL, NULL, NULL, NULL, NULL, 
   NULL, NULL, 
   NULL, NULL, NULL, 
@@ -260,7 +237,7 @@ KB_MATRIX_LAYER(
   NULL, NULL, NULL, NULL, NULL, NULL, NULL, 
   NULL, sshprre, sshprre, kprrel, kprrel, kprrel, NULL, 
   NULL, NULL, NULL, sanprre, NULL, NULL, 
-  NULL, vbuff, NULL, vsave, NULL, NULL, ktrans, 
+  NULL, mplay, NULL, mplay, NULL, NULL, ktrans, 
   NULL, NULL, NULL, NULL, NULL, 
   NULL, NULL, 
   NULL, NULL, NULL, 
@@ -270,7 +247,7 @@ KB_MATRIX_LAYER(
 // ----------------------------------------------------------------------------
 
 // RELEASE --------------------------------------------------------------------
-const void_funptr_t PROGMEM _kb_layout_release[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
+const void_funptr_t PROGMEM _kb_layout_release[][KB_ROWS][KB_COLUMNS] = {
 // LAYER 0
 KB_MATRIX_LAYER(
   // unused
@@ -365,3 +342,51 @@ KB_MATRIX_LAYER(
 ),
 };
 // ----------------------------------------------------------------------------
+
+// MACROS ---------------------------------------------------------------------
+// `->`
+static const uint8_t PROGMEM _macro_arrow[] = {
+  KEY_Dash_Underscore, MACRO_SHIFTED(KEY_Period_GreaterThan), MACRO_END };
+// `("`
+static const uint8_t PROGMEM _macro_parenthesis_double_quote[] = {
+  MACRO_SHIFTED(KEY_9_LeftParenthesis),
+  MACRO_SHIFTED(KEY_SingleQuote_DoubleQuote), MACRO_END };
+// `")`
+static const uint8_t PROGMEM _macro_double_quote_parenthesis[] = {
+  MACRO_SHIFTED(KEY_SingleQuote_DoubleQuote),
+  MACRO_SHIFTED(KEY_0_RightParenthesis), MACRO_END };
+// `<<"`
+static const uint8_t PROGMEM _macro_lt2_double_quote[] = {
+  MACRO_SHIFTED(KEY_Comma_LessThan), MACRO_SHIFTED(KEY_Comma_LessThan),
+  MACRO_SHIFTED(KEY_SingleQuote_DoubleQuote), MACRO_END };
+// `">>`
+static const uint8_t PROGMEM _macro_double_quote_gt2[] = {
+  MACRO_SHIFTED(KEY_SingleQuote_DoubleQuote),
+  MACRO_SHIFTED(KEY_Period_GreaterThan),
+  MACRO_SHIFTED(KEY_Period_GreaterThan), MACRO_END };
+// vim `:w<enter>`
+static const uint8_t PROGMEM _macro_vim_save[] = {
+  MACRO_SHIFTED(KEY_Semicolon_Colon), KEY_w_W, KEY_ReturnEnter, MACRO_END };
+// vim `:wq<enter>`
+static const uint8_t PROGMEM _macro_vim_save_and_quit[] = {
+  MACRO_SHIFTED(KEY_Semicolon_Colon), KEY_w_W, KEY_q_Q, KEY_ReturnEnter,
+  MACRO_END };
+// vim `:b <tab>`
+static const uint8_t PROGMEM _macro_vim_buffers[] = {
+  MACRO_SHIFTED(KEY_Semicolon_Colon), KEY_b_B, KEY_Spacebar, KEY_Tab,
+  MACRO_END };
+
+// indexed by the keycodes of the `mplay` keys on layer 3
+const uint8_t * const PROGMEM _kb_layout_macros[] = {
+  _macro_arrow,                    // 0
+  _macro_parenthesis_double_quote, // 1
+  _macro_double_quote_parenthesis, // 2
+  _macro_lt2_double_quote,         // 3
+  _macro_double_quote_gt2,         // 4
+  _macro_vim_save,                 // 5
+  _macro_vim_save_and_quit,        // 6
+  _macro_vim_buffers,              // 7
+};
+// ----------------------------------------------------------------------------
+
+KB_LAYOUT_LAYERS_DEFINE();
@@ -15,6 +15,10 @@
 	#define KB_ROWS      6  // must match real life
 	#define KB_COLUMNS  14  // must match real life
 
+	// the unused positions (see below), as a bitmask of columns for each row
+	// (no switch is wired there: one read pressed is an electrical fault)
+	#define KB_MATRIX_UNUSED  { 0x2001, 0, 0, 0x00C0, 0, 0 }
+
 	// --------------------------------------------------------------------
 
 	/* mapping from spatial position to matrix position
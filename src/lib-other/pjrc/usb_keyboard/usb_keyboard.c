@@ -74,10 +74,21 @@
 #define EXTRA_SIZE		8
 #define EXTRA_BUFFER		EP_DOUBLE_BUFFER
 
+// a console for "hid_listen" (from PJRC), only in debug builds
+#define DEBUG_INTERFACE		2
+#define DEBUG_ENDPOINT		3
+#define DEBUG_SIZE		USB_DEBUG_SIZE
+#define DEBUG_BUFFER		EP_DOUBLE_BUFFER
+
 
 static const uint8_t PROGMEM endpoint_config_table[] = {
 	1, EP_TYPE_INTERRUPT_IN,  EP_SIZE(KEYBOARD_SIZE) | KEYBOARD_BUFFER,
 	1, EP_TYPE_INTERRUPT_IN,  EP_SIZE(EXTRA_SIZE)    | EXTRA_BUFFER,    // 4
+#if MAKEFILE_DEBUG
+	1, EP_TYPE_INTERRUPT_IN,  EP_SIZE(DEBUG_SIZE)    | DEBUG_BUFFER,
+#else
+	0,
+#endif
 	0
 };
 
@@ -166,13 +177,35 @@ static const uint8_t PROGMEM extra_hid_report_desc[] = {
     0xc0,                          // END_COLLECTION
 };
 
+#if MAKEFILE_DEBUG
+// what "hid_listen" looks for
+static const uint8_t PROGMEM debug_hid_report_desc[] = {
+	0x06, 0x31, 0xFF,			// Usage Page 0xFF31 (vendor defined)
+	0x09, 0x74,				// Usage 0x74
+	0xA1, 0x53,				// Collection 0x53
+	0x75, 0x08,				// report size = 8 bits
+	0x15, 0x00,				// logical minimum = 0
+	0x26, 0xFF, 0x00,			// logical maximum = 255
+	0x95, DEBUG_SIZE,			// report count
+	0x09, 0x75,				// usage
+	0x81, 0x02,				// Input (array)
+	0xC0					// end collection
+};
+#endif
+
 #define KEYBOARD_HID_DESC_NUM                0
 #define KEYBOARD_HID_DESC_OFFSET             (9+(9+9+7)*KEYBOARD_HID_DESC_NUM+9)
 
 #   define EXTRA_HID_DESC_NUM           (KEYBOARD_HID_DESC_NUM + 1)
 #   define EXTRA_HID_DESC_OFFSET        (9+(9+9+7)*EXTRA_HID_DESC_NUM+9)
 
-#define NUM_INTERFACES                  (EXTRA_HID_DESC_NUM + 1)
+#if MAKEFILE_DEBUG
+#   define DEBUG_HID_DESC_NUM           (EXTRA_HID_DESC_NUM + 1)
+#   define DEBUG_HID_DESC_OFFSET        (9+(9+9+7)*DEBUG_HID_DESC_NUM+9)
+#   define NUM_INTERFACES               (DEBUG_HID_DESC_NUM + 1)
+#else
+#   define NUM_INTERFACES               (EXTRA_HID_DESC_NUM + 1)
+#endif
 #define CONFIG1_DESC_SIZE               (9+(9+9+7)*NUM_INTERFACES)
 //#define KEYBOARD_HID_DESC_OFFSET (9+9)
 static const uint8_t PROGMEM config1_descriptor[CONFIG1_DESC_SIZE] = {
@@ -240,6 +273,34 @@ static const uint8_t PROGMEM config1_descriptor[CONFIG1_DESC_SIZE] = {
 	0x03,					// bmAttributes (0x03=intr)
 	EXTRA_SIZE, 0,				// wMaxPacketSize
 	10,					// bInterval
+#if MAKEFILE_DEBUG
+	// interface descriptor, USB spec 9.6.5, page 267-269, Table 9-12
+	9,					// bLength
+	4,					// bDescriptorType
+	DEBUG_INTERFACE,			// bInterfaceNumber
+	0,					// bAlternateSetting
+	1,					// bNumEndpoints
+	0x03,					// bInterfaceClass (0x03 = HID)
+	0x00,					// bInterfaceSubClass
+	0x00,					// bInterfaceProtocol
+	0,					// iInterface
+	// HID descriptor, HID 1.11 spec, section 6.2.1
+	9,					// bLength
+	0x21,					// bDescriptorType
+	0x11, 0x01,				// bcdHID
+	0,					// bCountryCode
+	1,					// bNumDescriptors
+	0x22,					// bDescriptorType
+	sizeof(debug_hid_report_desc),		// wDescriptorLength
+	0,
+	// endpoint descriptor, USB spec 9.6.6, page 269-271, Table 9-13
+	7,					// bLength
+	5,					// bDescriptorType
+	DEBUG_ENDPOINT | 0x80,			// bEndpointAddress
+	0x03,					// bmAttributes (0x03=intr)
+	DEBUG_SIZE, 0,				// wMaxPacketSize
+	1,					// bInterval
+#endif
 };
 
 // If you're desperate for a little extra code memory, these strings
@@ -284,6 +345,11 @@ static struct descriptor_list_struct {
 	    // Extra HID Descriptor
 	{0x2100, EXTRA_INTERFACE, config1_descriptor+EXTRA_HID_DESC_OFFSET, 9},
 	{0x2200, EXTRA_INTERFACE, extra_hid_report_desc, sizeof(extra_hid_report_desc)},
+#if MAKEFILE_DEBUG
+	    // Debug HID Descriptor
+	{0x2100, DEBUG_INTERFACE, config1_descriptor+DEBUG_HID_DESC_OFFSET, 9},
+	{0x2200, DEBUG_INTERFACE, debug_hid_report_desc, sizeof(debug_hid_report_desc)},
+#endif
         // STRING descriptors
 	{0x0300, 0x0000, (const uint8_t *)&string0, 4},
 	{0x0301, 0x0409, (const uint8_t *)&string1, sizeof(STR_MANUFACTURER)},
@@ -374,6 +440,27 @@ int8_t usb_keyboard_press(uint8_t key, uint8_t modifier)
 
 // send the contents of keyboard_keys and keyboard_modifier_keys
 int8_t usb_keyboard_send(void)
+{
+	return usb_keyboard_send_report(keyboard_modifier_keys, keyboard_keys);
+}
+
+// is there room to send a report without waiting?
+uint8_t usb_keyboard_ready(void)
+{
+	uint8_t intr_state, ready;
+
+	if (!usb_configuration) return 0;
+	intr_state = SREG;
+	cli();
+	UENUM = KEYBOARD_ENDPOINT;
+	ready = UEINTX & (1<<RWAL);
+	SREG = intr_state;
+	return ready;
+}
+
+// send the given report (instead of the contents of keyboard_keys and
+// keyboard_modifier_keys, which are left alone)
+int8_t usb_keyboard_send_report(uint8_t modifier_keys, const uint8_t *keys)
 {
 	uint8_t i, intr_state, timeout;
 
@@ -395,10 +482,10 @@ int8_t usb_keyboard_send(void)
 		cli();
 		UENUM = KEYBOARD_ENDPOINT;
 	}
-	UEDATX = keyboard_modifier_keys;
+	UEDATX = modifier_keys;
 	UEDATX = 0;
 	for (i=0; i<6; i++) {
-		UEDATX = keyboard_keys[i];
+		UEDATX = keys[i];
 	}
 	UEINTX = 0x3A;
 	keyboard_idle_count = 0;
@@ -705,3 +792,26 @@ int8_t usb_extra_consumer_send()
 	return result;
 }
 
+#if MAKEFILE_DEBUG
+// send one report of USB_DEBUG_SIZE bytes to the debug console, if there's
+// room for it right now; never waits
+int8_t usb_debug_send(const uint8_t *data)
+{
+	uint8_t i, intr_state;
+
+	if (!usb_configuration) return -1;
+	intr_state = SREG;
+	cli();
+	UENUM = DEBUG_ENDPOINT;
+	if (!(UEINTX & (1<<RWAL))) {
+		SREG = intr_state;
+		return -1;
+	}
+	for (i=0; i<DEBUG_SIZE; i++) {
+		UEDATX = data[i];
+	}
+	UEINTX = 0x3A;
+	SREG = intr_state;
+	return 0;
+}
+#endif
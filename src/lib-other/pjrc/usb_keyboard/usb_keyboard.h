@@ -8,6 +8,8 @@ uint8_t usb_configured(void);		// is the USB port configured
 
 int8_t usb_keyboard_press(uint8_t key, uint8_t modifier);
 int8_t usb_keyboard_send(void);
+int8_t usb_keyboard_send_report(uint8_t modifier_keys, const uint8_t *keys);
+uint8_t usb_keyboard_ready(void);
 extern uint8_t keyboard_modifier_keys;
 extern uint8_t keyboard_keys[6];
 extern volatile uint8_t keyboard_leds;
@@ -20,6 +22,12 @@ extern uint16_t consumer_key;
 #define usb_debug_putchar(c)
 #define usb_debug_flush_output()
 
+// the debug console (see "src/lib/debug.h")
+#define USB_DEBUG_SIZE 32
+#if MAKEFILE_DEBUG
+int8_t usb_debug_send(const uint8_t *data);
+#endif
+
 int8_t usb_extra_consumer_send();
 
 #if 0  // removed in favor of equivalent code elsewhere ::Ben Blazak, 2012::
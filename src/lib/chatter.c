@@ -0,0 +1,99 @@
+/* ----------------------------------------------------------------------------
+ * chatter detection : code
+ *
+ * Costs 2 bits of state, and a byte of count, per key (about 110 bytes of
+ * SRAM for the ergoDOX).
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+// ----------------------------------------------------------------------------
+// conditional compile
+#if MAKEFILE_CHATTER
+// ----------------------------------------------------------------------------
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../keyboard/matrix.h"
+#include "./debug.h"
+#include "./chatter.h"
+
+// ----------------------------------------------------------------------------
+
+#if KB_COLUMNS > 16
+	#error "Expecting at most 16 columns (see `_raw` and `_changed`)"
+#endif
+
+// (bit `col` of each, for the key at `row`, `col`)
+static uint16_t _raw[KB_ROWS];      // the state read on the last scan
+static uint16_t _changed[KB_ROWS];  // whether it had changed on that scan
+
+static uint8_t _count[KB_ROWS][KB_COLUMNS];
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Count the bounces in the newly read matrix, and hold back the changes to
+ * keys that bounce too often (for a scan)
+ *
+ * Arguments
+ * - was: the matrix, as passed on last scan
+ * - is: the matrix, as just read; changed to what's to be passed on
+ *
+ * Note
+ * - To be called once per scan, right after the matrix is read.
+ */
+void chatter_update( bool was[KB_ROWS][KB_COLUMNS],
+                     bool is[KB_ROWS][KB_COLUMNS] ) {
+	for (uint8_t row=0; row<KB_ROWS; row++) {
+		for (uint8_t col=0; col<KB_COLUMNS; col++) {
+			uint16_t bit = (uint16_t)1 << col;
+			bool raw = is[row][col];
+			bool raw_changed = raw != !!(_raw[row] & bit);
+
+			if (raw_changed) {
+				_raw[row] ^= bit;
+
+				if ( (_changed[row] & bit) && _count[row][col] < 255 ) {
+					_count[row][col]++;
+					if (_count[row][col] == CHATTER_THRESHOLD)
+						dprintf("chatter: %u,%u\n", row, col);
+				}
+
+				_changed[row] |= bit;
+			} else {
+				_changed[row] &= ~bit;
+			}
+
+			// (not yet steady for two scans)
+			if (raw_changed && _count[row][col] >= CHATTER_THRESHOLD)
+				is[row][col] = was[row][col];
+		}
+	}
+}
+
+/*
+ * Get the number of bounces seen on the given key (up to 255)
+ */
+uint8_t chatter_count(uint8_t row, uint8_t col) {
+	return _count[row][col];
+}
+
+/*
+ * Forget the counts (so no key is slowed down any more)
+ */
+void chatter_reset(void) {
+	for (uint8_t row=0; row<KB_ROWS; row++)
+		for (uint8_t col=0; col<KB_COLUMNS; col++)
+			_count[row][col] = 0;
+}
+
+
+// ----------------------------------------------------------------------------
+#endif
+// ----------------------------------------------------------------------------
+
@@ -0,0 +1,53 @@
+/* ----------------------------------------------------------------------------
+ * chatter detection : exports
+ *
+ * A key that changes state on two scans in a row (released and pressed again,
+ * or pressed and released again, within about `MAKEFILE_DEBOUNCE_TIME`
+ * milliseconds) is bouncing: no finger is that quick.  Each time, the key's
+ * count goes up; once it reaches `CHATTER_THRESHOLD`, the key is debounced
+ * over two scans instead of one (a change goes through only if it's still
+ * there on the next scan).  Other keys aren't slowed down.
+ *
+ * The counts (which stop at 255) are kept until `chatter_reset()`.
+ *
+ * Compiled in only if `MAKEFILE_CHATTER` is set (see "makefile-options");
+ * otherwise these are empty macros, and nothing is held back.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#ifndef LIB__CHATTER_h
+	#define LIB__CHATTER_h
+
+	#include <stdbool.h>
+	#include <stdint.h>
+	#include "../keyboard/matrix.h"
+
+	// --------------------------------------------------------------------
+
+	#ifndef CHATTER_THRESHOLD
+		#define CHATTER_THRESHOLD  8  // bounces, before a key is slowed
+	#endif
+
+	// --------------------------------------------------------------------
+
+	#if MAKEFILE_CHATTER
+
+		void    chatter_update (bool was[KB_ROWS][KB_COLUMNS],
+		                        bool is[KB_ROWS][KB_COLUMNS]);
+		uint8_t chatter_count  (uint8_t row, uint8_t col);
+		void    chatter_reset  (void);
+
+	#else
+
+		#define  chatter_update(was, is)
+		#define  chatter_count(row, col)  0
+		#define  chatter_reset()
+
+	#endif
+
+#endif
+
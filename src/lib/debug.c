@@ -0,0 +1,141 @@
+/* ----------------------------------------------------------------------------
+ * debug console : code
+ *
+ * - Never waits.  A message that doesn't fit in the buffer is dropped (and
+ *   counted: the count is printed before the next message that fits), and
+ *   a report is sent only if the endpoint has room for it.
+ * - Not to be called from interrupts.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+// ----------------------------------------------------------------------------
+// conditional compile
+#if MAKEFILE_DEBUG
+// ----------------------------------------------------------------------------
+
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <avr/pgmspace.h>
+#include <util/delay.h>
+#include "../lib-other/pjrc/usb_keyboard/usb_keyboard.h"
+#include "./debug.h"
+
+// ----------------------------------------------------------------------------
+
+// must be a power of 2
+#define BUFFER_LENGTH  128
+
+// the longest message (longer ones are cut short)
+#define MESSAGE_LENGTH  64
+
+// how long `debug_drain()` waits for the host to take a report
+#define DRAIN_TIMEOUT  50  // in ms
+
+static char     _buffer[BUFFER_LENGTH];
+static uint8_t  _buffer_head;   // index of the next character to send
+static uint8_t  _buffer_count;  // number of characters waiting
+static uint16_t _dropped;       // messages dropped since the last printed
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Copy a message into the buffer, if there's room for all of it
+ */
+static bool _put(const char * message, uint8_t length) {
+	if (length > BUFFER_LENGTH - _buffer_count)
+		return false;
+
+	for (uint8_t i=0; i<length; i++)
+		_buffer[ (_buffer_head + _buffer_count++) & (BUFFER_LENGTH-1) ] =
+			message[i];
+
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void debug_printf(const char * format, ...) {
+	char message[MESSAGE_LENGTH];
+	int length;
+	va_list args;
+
+	if (_dropped) {
+		length = snprintf_P( message, MESSAGE_LENGTH,
+		                     PSTR("(%u dropped)\n"), _dropped );
+		if (!_put(message, length)) {
+			_dropped++;
+			return;
+		}
+		_dropped = 0;
+	}
+
+	va_start(args, format);
+	length = vsnprintf_P(message, MESSAGE_LENGTH, format, args);
+	va_end(args);
+
+	if (length >= MESSAGE_LENGTH)
+		length = MESSAGE_LENGTH-1;
+	if (length > 0 && !_put(message, length))
+		_dropped++;
+}
+
+/*
+ * Send the next report's worth of the buffer, if the endpoint can take it
+ *
+ * Note
+ * - To be called often (once per scan, and while waiting).
+ */
+void debug_flush(void) {
+	uint8_t report[USB_DEBUG_SIZE];
+	uint8_t length = 0;
+
+	if (!_buffer_count)
+		return;
+
+	while (length < USB_DEBUG_SIZE && length < _buffer_count) {
+		report[length] = _buffer[ (_buffer_head + length) & (BUFFER_LENGTH-1) ];
+		length++;
+	}
+	for (uint8_t i=length; i<USB_DEBUG_SIZE; i++)
+		report[i] = 0;  // ("hid_listen" stops at the first 0)
+
+	if (usb_debug_send(report))
+		return;  // (not ready; try again later)
+
+	_buffer_head = (_buffer_head + length) & (BUFFER_LENGTH-1);
+	_buffer_count -= length;
+}
+
+
+/*
+ * Send what's in the buffer, waiting for the host to take it
+ *
+ * Note
+ * - For printing more than fits in the buffer at once (e.g. a dump, a line
+ *   at a time).  Gives up after `DRAIN_TIMEOUT` milliseconds without a
+ *   report taken (e.g. if nothing on the host is listening).
+ */
+void debug_drain(void) {
+	for (uint8_t ms=0; _buffer_count && ms<DRAIN_TIMEOUT; ms++) {
+		uint8_t count = _buffer_count;
+
+		debug_flush();
+		if (_buffer_count != count)
+			ms = 0;
+		else
+			_delay_ms(1);
+	}
+}
+
+
+// ----------------------------------------------------------------------------
+#endif
+// ----------------------------------------------------------------------------
+
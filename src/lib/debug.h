@@ -0,0 +1,46 @@
+/* ----------------------------------------------------------------------------
+ * debug console : exports
+ *
+ * `dprintf()` formats a message (as `printf()` would) into a buffer in RAM;
+ * `debug_flush()` sends what's in the buffer, a report at a time, to the
+ * debug endpoint (see "lib-other/pjrc/usb_keyboard"), where "hid_listen"
+ * (from PJRC) can print it.
+ *
+ * Compiled in only if `MAKEFILE_DEBUG` is set (see "makefile-options");
+ * otherwise these are empty macros, and the format strings aren't even
+ * stored.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#ifndef LIB__DEBUG_h
+	#define LIB__DEBUG_h
+
+	#include <stdint.h>
+	#include <avr/pgmspace.h>
+
+	// --------------------------------------------------------------------
+
+	#if MAKEFILE_DEBUG
+
+		// (the format is kept in Flash)
+		#define  dprintf(format, ...)  \
+			debug_printf(PSTR(format), ##__VA_ARGS__)
+
+		void debug_printf (const char * format, ...);
+		void debug_flush  (void);
+		void debug_drain  (void);
+
+	#else
+
+		#define  dprintf(format, ...)
+		#define  debug_flush()
+		#define  debug_drain()
+
+	#endif
+
+#endif
+
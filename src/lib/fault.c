@@ -0,0 +1,183 @@
+/* ----------------------------------------------------------------------------
+ * matrix fault detection : code
+ *
+ * Works on bitmasks of each row, so the time taken is about the same on
+ * every scan: one pass over the matrix, one or two checks per pair of rows,
+ * and one pass over the rows.  Costs 8 bytes of SRAM per row, and 1 per
+ * pair of rows.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "../keyboard/matrix.h"
+#include "./debug.h"
+#include "./timer.h"
+#include "./fault.h"
+
+// ----------------------------------------------------------------------------
+
+#if KB_COLUMNS > 16
+	#error "Expecting at most 16 columns (see `_held` and others)"
+#endif
+
+#ifdef KB_MATRIX_UNUSED
+	static const uint16_t PROGMEM _unused[KB_ROWS] = KB_MATRIX_UNUSED;
+#else
+	static const uint16_t PROGMEM _unused[KB_ROWS];
+#endif
+
+// (bit `col` of each, for the key at `row`, `col`)
+static uint16_t _held[KB_ROWS];    // new presses being held back
+static uint16_t _shorts[KB_ROWS];  // unused positions reading pressed
+static uint16_t _steady[KB_ROWS];  // down since the last period began
+static uint16_t _stuck[KB_ROWS];   // released, and ignored until they are
+
+// (for each pair of rows, in order: 0,1 0,2 ... 1,2 ...)
+static uint8_t _matches[KB_ROWS*(KB_ROWS-1)/2];  // bridge checks in a row
+                                                 //   the pair has passed
+
+static uint16_t _time;     // when the last minute began
+static uint8_t  _minutes;  // of the current period
+
+static uint16_t _counts[FAULT_TYPES];
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Count a fault of the given type on each key in `keys`
+ */
+static void _count(uint8_t type, uint8_t row, uint16_t keys) {
+	for (uint8_t col=0; keys; col++, keys >>= 1) {
+		if (!(keys & 1))
+			continue;
+		if (_counts[type] < UINT16_MAX)
+			_counts[type]++;
+		dprintf("fault %u: %u,%u\n", type, row, col);
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Hold back the key presses that look like phantoms, and release the keys
+ * that look stuck
+ *
+ * Arguments
+ * - was: the matrix, as passed on last scan
+ * - is: the matrix, as just read; changed to what's to be passed on
+ *
+ * Note
+ * - To be called once per scan, right after the matrix is read (and after
+ *   `chatter_update()`).
+ */
+void fault_update( bool was[KB_ROWS][KB_COLUMNS],
+                   bool is[KB_ROWS][KB_COLUMNS] ) {
+	uint16_t down[KB_ROWS];     // as read
+	uint16_t passed[KB_ROWS];   // as passed on last scan
+	uint16_t ghosts[KB_ROWS];   // corners of rectangles
+	uint16_t short_columns = 0;
+
+	for (uint8_t row=0; row<KB_ROWS; row++) {
+		down[row] = passed[row] = 0;
+		for (uint8_t col=0; col<KB_COLUMNS; col++) {
+			down[row] |= (uint16_t)is[row][col] << col;
+			passed[row] |= (uint16_t)was[row][col] << col;
+		}
+
+		// shorts
+		uint16_t shorts = down[row] & pgm_read_word(&_unused[row]);
+		_count(FAULT_SHORT, row, shorts & ~_shorts[row]);
+		_shorts[row] = shorts;
+		short_columns |= shorts;
+		ghosts[row] = 0;
+	}
+
+	// ghosts: two rows with two or more columns in common
+	#if FAULT_CHECK_GHOSTS
+		for (uint8_t row=0; row<KB_ROWS; row++)
+			for (uint8_t other=row+1; other<KB_ROWS; other++) {
+				uint16_t common = down[row] & down[other];
+				if (common & (common-1)) {
+					ghosts[row] |= common;
+					ghosts[other] |= common;
+				}
+			}
+	#endif
+
+	// bridges: two rows whose new presses keep matching
+	if (FAULT_BRIDGE_PRESSES) {
+		uint8_t pair = 0;
+		for (uint8_t row=0; row<KB_ROWS; row++)
+			for (uint8_t other=row+1; other<KB_ROWS; other++, pair++) {
+				uint16_t new_row = down[row] & ~passed[row];
+				uint16_t new_other = down[other] & ~passed[other];
+				if (!(new_row | new_other))
+					continue;  // (nothing to go by)
+
+				if (new_row != new_other || down[row] != down[other]) {
+					_matches[pair] = 0;
+				} else if ( _matches[pair] < FAULT_BRIDGE_PRESSES
+				            && ++_matches[pair] == FAULT_BRIDGE_PRESSES ) {
+					if (_counts[FAULT_BRIDGE] < UINT16_MAX)
+						_counts[FAULT_BRIDGE]++;
+					dprintf("fault %u: rows %u,%u\n", FAULT_BRIDGE, row, other);
+				}
+			}
+	}
+
+	// stuck keys: down through a whole period
+	bool period = false;
+	if (FAULT_STUCK_MINUTES && timer_elapsed(_time) >= 60000) {
+		_time = timer_ms();  // (minutes spent idle aren't counted)
+		if (++_minutes >= FAULT_STUCK_MINUTES) {
+			_minutes = 0;
+			period = true;
+		}
+	}
+
+	for (uint8_t row=0; row<KB_ROWS; row++) {
+		_stuck[row] &= down[row];
+		_steady[row] &= down[row];
+		if (period) {
+			_count(FAULT_STUCK, row, _steady[row] & ~_stuck[row]);
+			_stuck[row] |= _steady[row];
+			_steady[row] = down[row];
+		}
+
+		// new presses where they aren't to be trusted (other than at the
+		// unused positions themselves, counted above)
+		uint16_t shorted = (_shorts[row] ? 0xFFFF : 0) | short_columns;
+		uint16_t held = down[row] & ~passed[row] & ~_stuck[row]
+		                & ~_shorts[row] & (shorted | ghosts[row]);
+		uint16_t new_held = held & ~_held[row];
+		_count(FAULT_SHORT, row, new_held & shorted);
+		_count(FAULT_GHOST, row, new_held & ~shorted);
+		_held[row] = held;
+
+		uint16_t off = held | _stuck[row] | _shorts[row];
+		for (uint8_t col=0; off; col++, off >>= 1)
+			if (off & 1)
+				is[row][col] = false;
+	}
+}
+
+/*
+ * Get the number of faults of the given type seen (up to 65535)
+ */
+uint16_t fault_count(uint8_t type) {
+	return _counts[type];
+}
+
+/*
+ * Whether the given key is being ignored, as stuck
+ */
+bool fault_stuck(uint8_t row, uint8_t col) {
+	return _stuck[row] & ((uint16_t)1 << col);
+}
+
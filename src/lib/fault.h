@@ -0,0 +1,73 @@
+/* ----------------------------------------------------------------------------
+ * matrix fault detection : exports
+ *
+ * With a diode on every key, the matrix should never show a key that isn't
+ * pressed.  A shorted diode, or a bridge between two lines, makes it show
+ * phantom keys; and a broken switch may stay down.  So, each scan:
+ * - ghosts (only if `FAULT_CHECK_GHOSTS`): where two rows share two or more
+ *   pressed columns (a rectangle), new presses at the corners are held back
+ *   until the rectangle is gone.  With a diode on every key, a rectangle is
+ *   almost always a real chord (two keys on each of two rows, in the same
+ *   columns), so this holds back keys that really were pressed: it's a
+ *   diagnostic, for looking for a shorted diode, and off by default.
+ * - shorts: where a position with no switch (see `KB_MATRIX_UNUSED`) reads
+ *   pressed, it is ignored, and new presses on its row and column are held
+ *   back, until it reads released
+ * - stuck keys: a key held through a whole `FAULT_STUCK_MINUTES` period (so
+ *   for between one and two of them) is released, and ignored until it
+ *   reads released
+ * - bridges: two rows bridged together read the same, so every press on
+ *   either shows up on both, in the same columns, in the same scan.  Where
+ *   the new presses on a pair of rows have matched, column for column,
+ *   `FAULT_BRIDGE_PRESSES` times in a row (and the rows matched as a
+ *   whole), the pair is reported.  Nothing is held back: which of the two
+ *   keys was pressed can't be told.
+ *
+ * Each unused position found pressed, each key held back (once per press),
+ * each key found stuck, and each pair of rows found bridged, is counted by
+ * type, and printed to the debug console.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#ifndef LIB__FAULT_h
+	#define LIB__FAULT_h
+
+	#include <stdbool.h>
+	#include <stdint.h>
+	#include "../keyboard/matrix.h"
+
+	// --------------------------------------------------------------------
+
+	#ifndef FAULT_CHECK_GHOSTS
+		#define FAULT_CHECK_GHOSTS  0  // (1 to hold back rectangles; a
+		                               //   diagnostic, see above)
+	#endif
+
+	#ifndef FAULT_STUCK_MINUTES
+		#define FAULT_STUCK_MINUTES  120  // (0 to never release a key)
+	#endif
+
+	#ifndef FAULT_BRIDGE_PRESSES
+		#define FAULT_BRIDGE_PRESSES  8  // (0 to not look for bridges)
+	#endif
+
+	// types of fault (see `fault_count()`)
+	#define FAULT_GHOST   0
+	#define FAULT_SHORT   1
+	#define FAULT_STUCK   2
+	#define FAULT_BRIDGE  3
+	#define FAULT_TYPES   4
+
+	// --------------------------------------------------------------------
+
+	void     fault_update (bool was[KB_ROWS][KB_COLUMNS],
+	                       bool is[KB_ROWS][KB_COLUMNS]);
+	uint16_t fault_count  (uint8_t type);
+	bool     fault_stuck  (uint8_t row, uint8_t col);
+
+#endif
+
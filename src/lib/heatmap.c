@@ -0,0 +1,164 @@
+/* ----------------------------------------------------------------------------
+ * key press heatmap : code
+ *
+ * The EEPROM keeps a ring of `SLOTS` copies of the counts, each with a
+ * sequence number (written last, so a copy cut short by a reset is ignored).
+ * Each save goes to the slot after the newest, so each slot is written only
+ * every `SLOTS`th time; and only the bytes that changed are written.  At the
+ * default interval, typing nonstop, a slot's 100,000 writes last about
+ * 11 years.
+ *
+ * - A save is written a byte at a time, when the EEPROM is ready (about
+ *   3.3 ms per byte that changed), over as many scans as it takes; the scan
+ *   never waits for it.
+ * - When a count would pass 65535, all the counts are halved (a heatmap is
+ *   only relative anyway).
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+// ----------------------------------------------------------------------------
+// conditional compile
+#if MAKEFILE_HEATMAP
+// ----------------------------------------------------------------------------
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <avr/eeprom.h>
+#include "../keyboard/matrix.h"
+#include "./timer.h"
+#include "./heatmap.h"
+
+// ----------------------------------------------------------------------------
+
+#define SLOTS  4  // 4 * 169 bytes, of the 1 kB of EEPROM
+
+#define SEQUENCE_NONE  0xFF  // (erased EEPROM)
+#define SEQUENCE_NEXT(sequence)  ( ((sequence) + 1) % SEQUENCE_NONE )
+
+static struct slot {
+	uint16_t counts[KB_ROWS][KB_COLUMNS];
+	uint8_t  sequence;  // (must be last)
+} EEMEM _slots[SLOTS];
+
+static uint16_t _counts[KB_ROWS][KB_COLUMNS];
+
+static uint8_t  _slot;      // the newest
+static uint8_t  _sequence;  // of the newest (`SEQUENCE_NONE` if none)
+
+static bool     _dirty;     // changed since the last save began
+static uint8_t  _minutes;   // since the last save began
+static uint16_t _time;      // when the current minute began
+
+static bool     _saving;
+static uint16_t _saved;     // bytes of the save written (or checked) so far
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Read the newest copy of the counts from the EEPROM (if there is one)
+ *
+ * Note
+ * - To be called once, at startup.
+ */
+void heatmap_init(void) {
+	_slot = 0;
+	_sequence = eeprom_read_byte(&_slots[0].sequence);
+
+	if (_sequence != SEQUENCE_NONE) {
+		// the newest is the last of the run of consecutive sequence numbers
+		for ( uint8_t next;
+		      _slot < SLOTS-1
+		      && ( next = eeprom_read_byte(&_slots[_slot+1].sequence) )
+		         == SEQUENCE_NEXT(_sequence);
+		      _slot++ )
+			_sequence = next;
+
+		eeprom_read_block(_counts, _slots[_slot].counts, sizeof(_counts));
+	}
+
+	_time = timer_ms();
+}
+
+/*
+ * Count a press of the given key
+ */
+void heatmap_press(uint8_t row, uint8_t col) {
+	if (_counts[row][col] == UINT16_MAX) {
+		for (uint8_t r=0; r<KB_ROWS; r++)
+			for (uint8_t c=0; c<KB_COLUMNS; c++)
+				_counts[r][c] /= 2;
+
+		_saved = 0;  // (start the save over, if there is one)
+	}
+
+	_counts[row][col]++;
+	_dirty = true;
+}
+
+/*
+ * Start saving the counts, if it's time; and write as much of a save as the
+ * EEPROM is ready for
+ *
+ * Note
+ * - To be called once per scan.
+ */
+void heatmap_tick(void) {
+	if (timer_elapsed(_time) >= 60000) {
+		_time += 60000;
+		if (_minutes < UINT8_MAX)
+			_minutes++;
+	}
+
+	if (!_saving && _dirty && _minutes >= HEATMAP_FLUSH_INTERVAL) {
+		_saving = true;
+		_saved = 0;
+		_dirty = false;
+		_minutes = 0;
+		_slot = (_sequence == SEQUENCE_NONE) ? 0 : (_slot + 1) % SLOTS;
+		_sequence = SEQUENCE_NEXT(_sequence);
+	}
+
+	if (!_saving)
+		return;
+
+	// (`eeprom_update_byte()` only waits if the EEPROM isn't ready; and
+	// takes no time at all for bytes that haven't changed)
+	for (; _saved < sizeof(_counts) && eeprom_is_ready(); _saved++)
+		eeprom_update_byte( (uint8_t *)_slots[_slot].counts + _saved,
+		                    ((uint8_t *)_counts)[_saved] );
+
+	if (_saved == sizeof(_counts) && eeprom_is_ready()) {
+		eeprom_update_byte(&_slots[_slot].sequence, _sequence);
+		_saving = false;
+	}
+}
+
+/*
+ * Get the number of presses counted for the given key
+ */
+uint16_t heatmap_get(uint8_t row, uint8_t col) {
+	return _counts[row][col];
+}
+
+/*
+ * Forget the counts (the EEPROM too, with the next save)
+ */
+void heatmap_reset(void) {
+	for (uint8_t row=0; row<KB_ROWS; row++)
+		for (uint8_t col=0; col<KB_COLUMNS; col++)
+			_counts[row][col] = 0;
+
+	_saved = 0;
+	_dirty = true;
+}
+
+
+// ----------------------------------------------------------------------------
+#endif
+// ----------------------------------------------------------------------------
+
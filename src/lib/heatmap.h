@@ -0,0 +1,51 @@
+/* ----------------------------------------------------------------------------
+ * key press heatmap : exports
+ *
+ * Counts the presses of each key (by matrix position), in RAM, and saves the
+ * counts to the EEPROM every `HEATMAP_FLUSH_INTERVAL` minutes (if they've
+ * changed), so they're kept across resets.  `kbfun_heatmap_dump` prints them
+ * in a form that "build-scripts/gen-layout.py" can draw (with
+ * `--heatmap-file`).
+ *
+ * Compiled in only if `MAKEFILE_HEATMAP` is set (see "makefile-options");
+ * otherwise these are empty macros.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#ifndef LIB__HEATMAP_h
+	#define LIB__HEATMAP_h
+
+	#include <stdint.h>
+
+	// --------------------------------------------------------------------
+
+	#ifndef HEATMAP_FLUSH_INTERVAL
+		#define HEATMAP_FLUSH_INTERVAL  15  // in minutes
+	#endif
+
+	// --------------------------------------------------------------------
+
+	#if MAKEFILE_HEATMAP
+
+		void     heatmap_init  (void);
+		void     heatmap_press (uint8_t row, uint8_t col);
+		void     heatmap_tick  (void);
+		uint16_t heatmap_get   (uint8_t row, uint8_t col);
+		void     heatmap_reset (void);
+
+	#else
+
+		#define  heatmap_init()
+		#define  heatmap_press(row, col)
+		#define  heatmap_tick()
+		#define  heatmap_get(row, col)  0
+		#define  heatmap_reset()
+
+	#endif
+
+#endif
+
@@ -0,0 +1,178 @@
+/* ----------------------------------------------------------------------------
+ * key functions : combos : code
+ *
+ * Keys that might be part of a combo (see "default--matrix-control.h") are
+ * held back when pressed, until either
+ * - a combo is complete (and no longer combo is still possible): its keycode
+ *   is pressed, and the keys' own functions never run, or
+ * - no combo is possible any more (another key is pressed, one of the held
+ *   back keys is released, or `KB_COMBO_TERM` runs out): the held back keys
+ *   are passed on, in order, as if nothing had happened.
+ *
+ * Keys that aren't part of any combo aren't held back at all (unless keys
+ * before them are; in which case the ones before them are let go at once).
+ *
+ * A combo's keycode is released when the first of its keys is; the releases
+ * of the others are swallowed.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../lib/timer.h"
+#include "../../keyboard/layout.h"
+#include "../../keyboard/matrix.h"
+#include "../../main.h"
+#include "./private.h"
+
+// ----------------------------------------------------------------------------
+#ifdef KB_LAYOUT_HAS_COMBOS
+// ----------------------------------------------------------------------------
+
+// the keys held back (pressed, in order)
+static struct {
+	uint8_t row;
+	uint8_t col;
+} _keys[KB_COMBO_KEYS_MAX];
+
+static uint8_t  _count;
+static uint8_t  _candidates;  // bit `n` set if combo `n` is still possible
+static uint16_t _time;        // when the first was pressed
+
+static uint8_t _active;  // bit `n` set if combo `n`'s keycode is pressed
+
+// bit set for keys (row * KB_COLUMNS + col) whose release is to be swallowed
+static uint8_t _swallow[(KB_ROWS*KB_COLUMNS + 7) / 8];
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Pass a key event on (to the next thing that might hold it back)
+ */
+static void _pass(uint8_t row, uint8_t col, bool is_pressed) {
+	if (!_kbfun_tap_hold_event(row, col, is_pressed))
+		main_key_exec(row, col, is_pressed);
+}
+
+/*
+ * Pass on all the keys held back
+ */
+static void _flush(void) {
+	uint8_t count = _count;
+
+	_count = 0;
+	_candidates = 0;
+	for (uint8_t i=0; i<count; i++)
+		_pass(_keys[i].row, _keys[i].col, true);
+}
+
+/*
+ * Fire the combo that the keys held back complete (if there is one, and no
+ * longer one is still possible)
+ *
+ * Arguments
+ * - force: fire a complete combo, even if a longer one is still possible
+ */
+static void _fire(bool force) {
+	uint8_t complete = 0xFF;
+
+	for (uint8_t n=0; n<8; n++) {
+		if (!(_candidates & (1<<n)))
+			continue;
+		uint8_t keys = kb_layout_combo_get(n, KB_COMBO_KEYS);
+		if (keys == _count)
+			complete = n;
+		else if (!force)
+			return;  // (a longer one is possible)
+	}
+
+	if (complete == 0xFF)
+		return;
+
+	for (uint8_t i=0; i<_count; i++) {
+		uint8_t key = _keys[i].row * KB_COLUMNS + _keys[i].col;
+		_swallow[key >> 3] |= (1 << (key & 7));
+	}
+	_count = 0;
+	_candidates = 0;
+
+	_active |= (1 << complete);
+	_kbfun_press_release(true, kb_layout_combo_get(complete, KB_COMBO_KEYCODE));
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Hold back the given key event, if it might be part of a combo
+ *
+ * Returns
+ * - true: if the event was held back, or swallowed
+ * - false: if it should be passed on now
+ */
+bool _kbfun_combo_event(uint8_t row, uint8_t col, bool is_pressed) {
+	uint8_t mask = kb_layout_combo_keys_get(row, col);
+
+	if (!is_pressed) {
+		uint8_t key = row * KB_COLUMNS + col;
+
+		if (_swallow[key >> 3] & (1 << (key & 7))) {
+			_swallow[key >> 3] &= ~(1 << (key & 7));
+			for (uint8_t n=0; n<8; n++)
+				if (mask & _active & (1<<n)) {
+					_active &= ~(1<<n);
+					_kbfun_press_release( false,
+						kb_layout_combo_get(n, KB_COMBO_KEYCODE) );
+				}
+			return true;
+		}
+
+		for (uint8_t i=0; i<_count; i++)
+			if (_keys[i].row == row && _keys[i].col == col)
+				_flush();  // (released too soon to be a combo)
+
+		return false;
+	}
+
+	if (_count && !(mask & _candidates))
+		_flush();  // (this key isn't part of any combo the others could be)
+
+	if (!mask)
+		return false;
+
+	if (!_count) {
+		_candidates = mask;
+		_time = timer_ms();
+	} else {
+		_candidates &= mask;
+	}
+	_keys[_count].row = row;
+	_keys[_count].col = col;
+	_count++;
+
+	_fire(_count == KB_COMBO_KEYS_MAX);
+	if (_count == KB_COMBO_KEYS_MAX)
+		_flush();  // (no room for more)
+	return true;
+}
+
+/*
+ * Give up on (or fire) a combo, if the first key was pressed long enough ago
+ *
+ * Note
+ * - To be called once per scan.
+ */
+void _kbfun_combo_tick(void) {
+	if (_count && timer_elapsed(_time) >= KB_COMBO_TERM) {
+		_fire(true);
+		_flush();
+	}
+}
+
+// ----------------------------------------------------------------------------
+#endif
+// ----------------------------------------------------------------------------
+
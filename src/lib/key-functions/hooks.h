@@ -0,0 +1,76 @@
+/* ----------------------------------------------------------------------------
+ * key functions : hooks : exports
+ *
+ * What the main loop calls, other than the key functions themselves (see
+ * "main.c").  Everything else in "private.h" is for the key functions only.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#ifndef LIB__KEY_FUNCTIONS__HOOKS_h
+	#define LIB__KEY_FUNCTIONS__HOOKS_h
+
+	#include <stdbool.h>
+	#include <stdint.h>
+	#include "../../keyboard/layout.h"
+
+	// --------------------------------------------------------------------
+
+	// macro player (see "macro.c")
+	bool _kbfun_macro_room (void);
+	bool _kbfun_macro_busy (void);
+	void _kbfun_macro_send (void);
+
+	// key events, before they're executed (see `main_key_event()`)
+	bool _kbfun_tap_dance_event (uint8_t row, uint8_t col, bool is_pressed);
+	bool _kbfun_tap_hold_event  (uint8_t row, uint8_t col, bool is_pressed);
+
+	// forget the ids of the layers pushed (after a keymap switch has
+	// popped them all; see `main_keymap_select()`)
+	void _kbfun_layer_reset       (void);  // (see "public/basic.c")
+	void _kbfun_numpad_reset      (void);  // (see "public/special.c")
+	void _kbfun_macro_layer_reset (void);
+
+	// once per scan (see `_main_tick()`)
+	void _kbfun_tap_hold_tick  (void);
+	void _kbfun_tap_dance_tick (void);
+	void _kbfun_one_shot_tick  (void);
+
+	// (only if `MAKEFILE_MACRO_RECORD`; see "makefile-options")
+	#if MAKEFILE_MACRO_RECORD
+		void _kbfun_macro_record_tick (void);
+	#else
+		#define  _kbfun_macro_record_tick()
+	#endif
+
+	// combos (see "combo.c"); without any, nothing to call
+	#ifdef KB_LAYOUT_HAS_COMBOS
+		bool _kbfun_combo_event (uint8_t row, uint8_t col, bool is_pressed);
+		void _kbfun_combo_tick  (void);
+	#else
+		static inline bool _kbfun_combo_event( uint8_t row, uint8_t col,
+		                                       bool is_pressed ) {
+			return false;
+		}
+		static inline void _kbfun_combo_tick(void) {}
+	#endif
+
+	// leader key (see "leader.c"); without a trie, nothing to call
+	#ifdef KB_LAYOUT_HAS_LEADER
+		void _kbfun_leader_start (void);
+		bool _kbfun_leader_event (uint8_t row, uint8_t col, bool is_pressed);
+		void _kbfun_leader_tick  (void);
+	#else
+		static inline void _kbfun_leader_start(void) {}
+		static inline bool _kbfun_leader_event( uint8_t row, uint8_t col,
+		                                        bool is_pressed ) {
+			return false;
+		}
+		static inline void _kbfun_leader_tick(void) {}
+	#endif
+
+#endif
+
@@ -0,0 +1,156 @@
+/* ----------------------------------------------------------------------------
+ * key functions : leader key : code
+ *
+ * While a leader sequence is being typed, the keycodes that plain keys
+ * (`kbfun_press_release` and the like) would send are looked up in the
+ * layout's trie (see "default--matrix-control.h") instead of being sent.
+ * The leader sees key events before anything else (see `main_key_event()`),
+ * so keys that a combo or a tap-hold key would hold back are looked up at
+ * once.  The keys it takes are remembered, so their releases are taken as
+ * well.  Other keys (modifiers, layer keys, and so on) are passed on as
+ * usual.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../lib/timer.h"
+#include "../../lib/usb/usage-page/keyboard.h"
+#include "../../keyboard/layout.h"
+#include "../../keyboard/matrix.h"
+#include "../../main.h"
+#include "./public.h"
+#include "./private.h"
+
+// ----------------------------------------------------------------------------
+#ifdef KB_LAYOUT_HAS_LEADER
+// ----------------------------------------------------------------------------
+
+#if KB_COLUMNS > 16
+	#error "Expecting at most 16 columns (see `_taken`)"
+#endif
+
+static bool     _active;
+static uint8_t  _node;  // offset of the current node, in the trie
+static uint16_t _time;  // of the last key
+
+static uint16_t _taken[KB_ROWS];  // bit `col`, for each key pressed, and
+                                  //   not yet released, that was taken
+
+// ----------------------------------------------------------------------------
+
+/*
+ * End the sequence, playing the current node's macro (if it has one)
+ */
+static void _finish(void) {
+	uint8_t macro = kb_layout_leader_get(_node);
+
+	_active = false;
+	if (macro)
+		_kbfun_macro_play(kb_layout_macro_get(macro-1));
+}
+
+/*
+ * Get the keycode the given key would send, if it's a plain key
+ *
+ * Returns
+ * - the keycode: if it's a plain key, and not a modifier
+ * - 0: otherwise
+ */
+static uint8_t _keycode(uint8_t row, uint8_t col) {
+	uint8_t offset = 0;
+	uint8_t layer;
+	void (*function)(void);
+
+	// (down the stack, past transparent keys; `offset` wraps, should the
+	// base layer's key be transparent too)
+	do {
+		layer = main_layers_peek_layout(offset++);
+		function = kb_layout_press_get(layer, row, col);
+	} while (function == &kbfun_transparent && offset);
+
+	if ( function != &kbfun_press_release
+	     && function != &kbfun_press_release_preserve_sticky )
+		return 0;
+
+	uint8_t keycode = kb_layout_get(layer, row, col);
+	if (keycode >= KEY_LeftControl && keycode <= KEY_RightGUI)
+		return 0;
+
+	return keycode;
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Start a sequence (at the root of the trie)
+ */
+void _kbfun_leader_start(void) {
+	_active = true;
+	_node = 0;
+	_time = timer_ms();
+}
+
+/*
+ * Look up a key (if a sequence is being typed), or take the release of one
+ * that was
+ *
+ * Returns
+ * - true: if the event was taken (and isn't to be passed on)
+ * - false: otherwise
+ *
+ * Note
+ * - Called for every key event, before anything else sees it.
+ */
+bool _kbfun_leader_event(uint8_t row, uint8_t col, bool is_pressed) {
+	uint16_t bit = (uint16_t)1 << col;
+
+	if (!is_pressed) {
+		if (!(_taken[row] & bit))
+			return false;
+		_taken[row] &= ~bit;
+		return true;
+	}
+
+	if (!_active)
+		return false;
+
+	uint8_t keycode = _keycode(row, col);
+	if (!keycode)
+		return false;
+
+	_taken[row] |= bit;
+	_time = timer_ms();
+
+	uint8_t children = kb_layout_leader_get(_node+1);
+	for (uint8_t i=0; i<children; i++)
+		if (kb_layout_leader_get(_node+2 + 2*i) == keycode) {
+			_node = kb_layout_leader_get(_node+3 + 2*i);
+			if (!kb_layout_leader_get(_node+1))
+				_finish();  // (a leaf)
+			return true;
+		}
+
+	_finish();  // (nowhere to go)
+	return true;
+}
+
+/*
+ * End the sequence, if no key has been typed for long enough
+ *
+ * Note
+ * - To be called once per scan.
+ */
+void _kbfun_leader_tick(void) {
+	if (_active && timer_elapsed(_time) >= KB_LEADER_TIMEOUT)
+		_finish();
+}
+
+// ----------------------------------------------------------------------------
+#endif
+// ----------------------------------------------------------------------------
+
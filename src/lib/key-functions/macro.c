@@ -0,0 +1,414 @@
+/* ----------------------------------------------------------------------------
+ * key functions : macro player : code
+ *
+ * Plays keystrokes generated by key functions (e.g. "type this sequence")
+ * out to the host over the following USB reports, instead of blocking the
+ * main loop with `_delay_ms()`s between them.
+ *
+ * - Each queued tap takes two reports: one with the key down, and one with
+ *   it up.  Keys the user is holding are left as they are in both.
+ *
+ * - The main loop sends every report through `_kbfun_macro_send()`, and
+ *   gives the player another turn whenever the host is ready to take one
+ *   (see "main.c"), so taps go out as fast as the host polls for them.
+ *
+ * - Longer macros are written as programs (see "private.h" for the bytecode),
+ *   stored in Flash, and interpreted a step at a time: only once the taps
+ *   already queued have been played.  This way a program is never copied
+ *   into RAM, and its layer operations happen in order with its keystrokes.
+ *
+ * - One program, in RAM, may be recorded at runtime from the keys actually
+ *   pressed and released (as `_kbfun_press_release()` sees them, after
+ *   layers and transparency have been resolved), replayed, and saved to the
+ *   EEPROM; if `MAKEFILE_MACRO_RECORD` is set (see "makefile-options").
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <avr/eeprom.h>
+#include <avr/pgmspace.h>
+#include "../../lib-other/pjrc/usb_keyboard/usb_keyboard.h"
+#include "../../lib/usb/usage-page/keyboard.h"
+#include "../../main.h"
+#include "./private.h"
+
+// ----------------------------------------------------------------------------
+
+// must be a power of 2
+#define QUEUE_LENGTH  16
+
+// the most taps a key function queues at once (a unicode character takes up
+// to 9; see "unicode.c"): key events wait until there's room for this many
+// (see `_kbfun_macro_room()`)
+#define QUEUE_ROOM  9
+
+static struct {
+	uint8_t modifiers;      // held for the whole tap
+	uint8_t tap_modifiers;  // held only with the key (e.g. shift, for '(')
+	uint8_t keycode;
+} _queue[QUEUE_LENGTH];
+
+static uint8_t _queue_head;   // index of the tap being played
+static uint8_t _queue_count;  // number of taps queued (including that one)
+static bool    _key_is_down;  // whether the tap's 'down' report has been sent
+static uint8_t _fence;        // taps to send before key events go on
+
+// must be a power of 2
+#define PROGRAMS_LENGTH  4
+
+static struct {
+	const uint8_t * next;  // the next byte to interpret
+	bool in_ram;           // (else in Flash)
+} _programs[PROGRAMS_LENGTH];
+
+static uint8_t _programs_head;   // index of the program being interpreted
+static uint8_t _programs_count;  // number of programs waiting (including it)
+static uint8_t _modifiers;       // held by the program (`MACRO_DOWN`)
+static uint8_t _keys[6];         // held by the program (`MACRO_DOWN`)
+static uint8_t _delay;           // reports left to wait (`MACRO_DELAY`)
+static uint8_t _layer_id;        // of the layer it pushed (`MACRO_LAYER_PUSH`)
+
+#if MAKEFILE_MACRO_RECORD
+
+// the recorded program (always `MACRO_END` terminated)
+#define RECORD_LENGTH  64
+
+static uint8_t       _record[RECORD_LENGTH];
+static uint8_t EEMEM _record_eeprom[RECORD_LENGTH];
+
+static uint8_t _record_length;  // bytes recorded (not counting `MACRO_END`)
+static bool    _recording;
+static bool    _record_loaded;  // whether `_record` holds anything yet (if
+                                //   not, the EEPROM copy is used)
+static uint8_t _record_saved = RECORD_LENGTH;  // bytes written, of the save
+                                               //   in progress (if any)
+
+#endif
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Read the next byte of the program being played
+ */
+static uint8_t _read(void) {
+	const uint8_t * next = _programs[_programs_head].next++;
+
+	return (_programs[_programs_head].in_ram) ? *next : pgm_read_byte(next);
+}
+
+/*
+ * Hold (or let go of) a key, for the program being played
+ */
+static void _hold(bool press, uint8_t keycode) {
+	if (keycode >= KEY_LeftControl && keycode <= KEY_RightGUI) {
+		if (press)
+			_modifiers |= 1 << (keycode - KEY_LeftControl);
+		else
+			_modifiers &= ~(1 << (keycode - KEY_LeftControl));
+		return;
+	}
+
+	for (uint8_t i=0; i<6; i++)  // (never hold a key twice)
+		if (_keys[i] == keycode)
+			_keys[i] = 0;
+
+	if (press)
+		for (uint8_t i=0; i<6; i++)
+			if (!_keys[i]) {
+				_keys[i] = keycode;
+				return;
+			}
+}
+
+/*
+ * Interpret the next instruction of the program being played
+ */
+static void _step(void) {
+	uint8_t op = _read();
+
+	if (op < MACRO_DOWN && op != MACRO_END) {
+		_kbfun_macro_tap(_modifiers, 0, op);
+		return;
+	}
+
+	uint8_t arg = (op == MACRO_END || op > MACRO_LAYER_PUSH) ? 0 : _read();
+
+	switch (op) {
+		default:  // (not an opcode: stop, rather than guess)
+		case MACRO_END:
+			_programs_head = (_programs_head + 1) & (PROGRAMS_LENGTH-1);
+			_programs_count--;
+			_modifiers = 0;
+			for (uint8_t i=0; i<6; i++)
+				_keys[i] = 0;
+			return;
+		case MACRO_DOWN:
+		case MACRO_UP:
+			_hold(op == MACRO_DOWN, arg);
+			_kbfun_macro_tap(_modifiers, 0, 0);
+			return;
+		case MACRO_MODS:
+			_kbfun_macro_tap(_modifiers, arg, _read());
+			return;
+		case MACRO_DELAY:
+			_delay = arg;
+			return;
+		case MACRO_LAYER_PUSH:
+			_layer_id = main_layers_push(arg, eStickyNone);
+			return;
+		case MACRO_LAYER_POP:
+			main_layers_pop_id(_layer_id);
+			_layer_id = 0;
+			return;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Queue a keystroke (press, then release) to be sent to the host
+ *
+ * Arguments
+ * - modifiers: the modifier byte to send with both reports (usually
+ *   `keyboard_modifier_keys`, as it is when the tap is queued)
+ * - tap_modifiers: modifiers to add to the 'down' report only
+ * - keycode: the keycode to tap; may be a modifier keycode, or 0 for none
+ *
+ * Note
+ * - If the queue is full, taps are played (blocking) until there's room.
+ */
+void _kbfun_macro_tap(uint8_t modifiers, uint8_t tap_modifiers,
+		uint8_t keycode) {
+	while (_queue_count == QUEUE_LENGTH)
+		_kbfun_macro_send();
+
+	uint8_t i = (_queue_head + _queue_count) & (QUEUE_LENGTH-1);
+	_queue[i].modifiers = modifiers;
+	_queue[i].tap_modifiers = tap_modifiers;
+	_queue[i].keycode = keycode;
+	_queue_count++;
+}
+
+/*
+ * Hold key events back (see `_kbfun_macro_room()`) until the taps queued so
+ * far have been sent, so that what they do goes out after them
+ *
+ * Note
+ * - Takes two reports per tap: with the host polling every 10 ms, that's
+ *   20 ms for each.  The scan goes on meanwhile.
+ */
+void _kbfun_macro_fence(void) {
+	_fence = _queue_count;
+}
+
+/*
+ * Queue a program (in Flash) to be played
+ *
+ * Arguments
+ * - program: a `MACRO_END` terminated sequence of instructions (see
+ *   "private.h")
+ *
+ * Note
+ * - Programs are played one after another.  If too many are waiting, they're
+ *   played (blocking) until there's room.
+ */
+static void _play(const uint8_t * program, bool in_ram) {
+	while (_programs_count == PROGRAMS_LENGTH)
+		_kbfun_macro_send();
+
+	uint8_t i = (_programs_head + _programs_count) & (PROGRAMS_LENGTH-1);
+	_programs[i].next = program;
+	_programs[i].in_ram = in_ram;
+	_programs_count++;
+}
+
+void _kbfun_macro_play(const uint8_t * program) {
+	_play(program, false);
+}
+
+/*
+ * Forget the id of the layer pushed (it's been popped, by
+ * `main_keymap_select()`)
+ */
+void _kbfun_macro_layer_reset(void) {
+	_layer_id = 0;
+}
+
+/*
+ * Is there room for whatever a key function might queue?
+ *
+ * Note
+ * - Key events wait while there isn't (see `main()`), so a key function
+ *   never has to wait (playing taps, blocking) for the queue to empty.
+ */
+bool _kbfun_macro_room(void) {
+	return !_fence
+	       && _queue_count <= QUEUE_LENGTH - QUEUE_ROOM
+	       && _programs_count < PROGRAMS_LENGTH;
+}
+
+/*
+ * Is a macro still playing?
+ */
+bool _kbfun_macro_busy(void) {
+	return _queue_count || _programs_count;
+}
+
+/*
+ * Send the next USB keyboard report
+ *
+ * Either the next step of the macro being played, or (if none is) the usual
+ * report, built from `keyboard_keys` and `keyboard_modifier_keys`.
+ *
+ * Note
+ * - If the report can't be sent (e.g. the keyboard isn't configured) the
+ *   step is dropped anyway, so that a full queue can't hang the caller.
+ */
+void _kbfun_macro_send(void) {
+	// once the queued taps have been played, interpret more of the program
+	while (!_queue_count && !_delay && _programs_count)
+		_step();
+
+	if (!_queue_count) {
+		if (_delay)
+			_delay--;
+		usb_keyboard_send();
+		return;
+	}
+
+	uint8_t modifiers = _queue[_queue_head].modifiers;
+	uint8_t keycode   = _queue[_queue_head].keycode;
+	uint8_t keys[6];
+
+	// the user's keys, and then the program's (as many as fit)
+	for (uint8_t i=0, j=0; i<6; i++) {
+		keys[i] = keyboard_keys[i];
+		while (!keys[i] && j<6)
+			keys[i] = _keys[j++];
+	}
+
+	if (!_key_is_down) {
+		modifiers |= _queue[_queue_head].tap_modifiers;
+
+		if (keycode >= KEY_LeftControl && keycode <= KEY_RightGUI) {
+			modifiers |= 1 << (keycode - KEY_LeftControl);
+		} else if (keycode) {
+			uint8_t i = 0;
+			while (i < 5 && keys[i] && keys[i] != keycode)
+				i++;
+			keys[i] = keycode;  // (over the last key, if none are free)
+		}
+	}
+
+	usb_keyboard_send_report(modifiers, keys);
+
+	// (taps of nothing only change the modifiers, and need no 'up' report)
+	if (_key_is_down || (!keycode && !_queue[_queue_head].tap_modifiers)) {
+		_queue_head = (_queue_head + 1) & (QUEUE_LENGTH-1);
+		_queue_count--;
+		_key_is_down = false;
+		if (_fence)
+			_fence--;
+	} else {
+		_key_is_down = true;
+	}
+}
+
+// ----------------------------------------------------------------------------
+#if MAKEFILE_MACRO_RECORD
+// ----------------------------------------------------------------------------
+
+/*
+ * Record a key being pressed or released (if recording)
+ *
+ * Note
+ * - Called by `_kbfun_press_release()`, for every key it's given.
+ * - Recording stops by itself when the buffer is full.
+ */
+void _kbfun_macro_record(bool press, uint8_t keycode) {
+	if (!_recording || keycode == 0)
+		return;
+
+	if (_record_length + 2 >= RECORD_LENGTH) {
+		_kbfun_macro_record_toggle();
+		return;
+	}
+
+	_record[_record_length++] = (press) ? MACRO_DOWN : MACRO_UP;
+	_record[_record_length++] = keycode;
+	_record[_record_length] = MACRO_END;
+}
+
+/*
+ * Start (or stop) recording
+ *
+ * Note
+ * - Doesn't start while a macro is playing, in case it's the recorded one;
+ *   nor while it's being saved.
+ */
+void _kbfun_macro_record_toggle(void) {
+	if (!_recording && (_kbfun_macro_busy() || _record_saved < RECORD_LENGTH))
+		return;
+
+	_recording = !_recording;
+	if (_recording) {
+		_record_length = 0;
+		_record[0] = MACRO_END;
+	}
+	_record_loaded = true;
+}
+
+/*
+ * Replay what was last recorded (or, if nothing has been recorded since the
+ * keyboard was plugged in, what was last saved)
+ */
+void _kbfun_macro_replay(void) {
+	if (_recording)
+		return;
+
+	if (!_record_loaded) {
+		eeprom_read_block(_record, _record_eeprom, RECORD_LENGTH);
+		_record[RECORD_LENGTH-1] = MACRO_END;
+		if (_record[0] == 0xFF)  // (erased EEPROM)
+			_record[0] = MACRO_END;
+		_record_loaded = true;
+	}
+
+	_play(_record, true);
+}
+
+/*
+ * Start saving what was last recorded to the EEPROM (see
+ * `_kbfun_macro_record_tick()`)
+ */
+void _kbfun_macro_record_save(void) {
+	if (_recording || !_record_loaded)
+		return;
+
+	_record_saved = 0;
+}
+
+/*
+ * Write as much of a save as the EEPROM is ready for
+ *
+ * Note
+ * - To be called once per scan.  A byte that changed takes about 3.3 ms to
+ *   write, so a whole save may take a couple hundred milliseconds; the scan
+ *   never waits for it.
+ */
+void _kbfun_macro_record_tick(void) {
+	// (`eeprom_update_byte()` only waits if the EEPROM isn't ready; and
+	// takes no time at all for bytes that haven't changed)
+	for (; _record_saved < RECORD_LENGTH && eeprom_is_ready(); _record_saved++)
+		eeprom_update_byte( &_record_eeprom[_record_saved],
+		                    _record[_record_saved] );
+}
+
+// ----------------------------------------------------------------------------
+#endif
+// ----------------------------------------------------------------------------
@@ -0,0 +1,148 @@
+/* ----------------------------------------------------------------------------
+ * key functions : one-shot modifiers and layers : code
+ *
+ * A one-shot modifier is held while its key is, like any other; but if no
+ * other key was pressed meanwhile, it stays held after the key is released,
+ * for the next key pressed only.  Several may be waiting at once (e.g. shift
+ * then control, for ctrl+shift+key).  Each:
+ * - is let go of `KB_ONE_SHOT_TIMEOUT` milliseconds after the last one-shot
+ *   key was released, if no other key was pressed
+ * - is locked, if its key is tapped again within `KB_TAPPING_TERM`; and then
+ *   let go of the next time its key is pressed
+ *
+ * Sticky layers (see `layer_sticky()` in "public/basic.c") time out the same
+ * way, once released: the layer is popped `KB_ONE_SHOT_TIMEOUT` milliseconds
+ * after it went into `eStickyOnceUp`.
+ *
+ * Other keys cost one check of `_kbfun_one_shot_mods` (in
+ * `_kbfun_press_release()`) per press.  Modifier keys don't use up a one-shot
+ * modifier.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../lib-other/pjrc/usb_keyboard/usb_keyboard.h"
+#include "../../lib/timer.h"
+#include "../../lib/usb/usage-page/keyboard.h"
+#include "../../keyboard/layout.h"
+#include "../../main.h"
+#include "./private.h"
+
+// ----------------------------------------------------------------------------
+
+// (bit `n` is for the modifier with keycode `KEY_LeftControl + n`, as in the
+// modifier byte of a USB report)
+uint8_t _kbfun_one_shot_mods;  // down, or waiting (see below)
+
+static uint8_t  _down;         // keys down
+static uint8_t  _used;         // keys down, that another key was pressed with
+static uint8_t  _waiting;      // released unused; held for the next key
+static uint8_t  _locked;
+static uint16_t _time;         // when the last was released
+
+static uint8_t  _layer_id;     // of the sticky layer waiting (0 = none)
+static uint16_t _layer_time;   // when it started waiting
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Press or release a one-shot modifier's key
+ *
+ * Arguments
+ * - press: whether the key was pressed (true) or released (false)
+ * - keycode: a modifier's keycode (`KEY_LeftControl` .. `KEY_RightGUI`)
+ */
+void _kbfun_one_shot_press_release(bool press, uint8_t keycode) {
+	if (keycode < KEY_LeftControl || keycode > KEY_RightGUI)
+		return;
+
+	uint8_t bit = 1 << (keycode - KEY_LeftControl);
+
+	if (press) {
+		if (_locked & bit) {
+			_locked &= ~bit;
+			_kbfun_press_release(false, keycode);
+		} else if ( (_waiting & bit)
+		            && timer_elapsed(_time) < KB_TAPPING_TERM ) {
+			_waiting &= ~bit;
+			_locked |= bit;
+		} else {
+			_waiting &= ~bit;
+			_down |= bit;
+			_used &= ~bit;
+			_kbfun_press_release(true, keycode);
+		}
+	} else if (_down & bit) {
+		_down &= ~bit;
+		if (_used & bit) {
+			_kbfun_press_release(false, keycode);
+		} else {
+			_waiting |= bit;
+			_time = timer_ms();
+		}
+	}
+
+	_kbfun_one_shot_mods = _down | _waiting;
+}
+
+/*
+ * Use up the one-shot modifiers (another key was just pressed)
+ *
+ * Note
+ * - Called by `_kbfun_press_release()`, only if `_kbfun_one_shot_mods`.
+ * - The waiting modifiers go out with the key in the next report (queued
+ *   with the macro player, see "macro.c"), and not in the ones after it.
+ */
+void _kbfun_one_shot_use(void) {
+	_used |= _down;
+
+	if (_waiting) {
+		_kbfun_macro_tap(keyboard_modifier_keys, 0, 0);
+		keyboard_modifier_keys &= ~_waiting;
+		_waiting = 0;
+	}
+
+	_kbfun_one_shot_mods = _down;
+}
+
+/*
+ * Start timing a sticky layer that was just pushed in `eStickyOnceUp`
+ */
+void _kbfun_one_shot_layer(uint8_t id) {
+	_layer_id = id;
+	_layer_time = timer_ms();
+}
+
+/*
+ * Let go of the modifiers (and pop the sticky layer) waiting too long
+ *
+ * Note
+ * - To be called once per scan.
+ */
+void _kbfun_one_shot_tick(void) {
+	if (!KB_ONE_SHOT_TIMEOUT)
+		return;
+
+	if (_waiting && timer_elapsed(_time) >= KB_ONE_SHOT_TIMEOUT) {
+		keyboard_modifier_keys &= ~_waiting;
+		_waiting = 0;
+		_kbfun_one_shot_mods = _down;
+	}
+
+	if (_layer_id) {
+		// (only the topmost layer may be in `eStickyOnceUp`)
+		if ( main_layers_peek_sticky(0) != eStickyOnceUp
+		     || main_layers_get_offset_id(_layer_id) != 0 ) {
+			_layer_id = 0;
+		} else if (timer_elapsed(_layer_time) >= KB_ONE_SHOT_TIMEOUT) {
+			main_layers_pop_id(_layer_id);
+			_layer_id = 0;
+		}
+	}
+}
+
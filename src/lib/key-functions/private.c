@@ -15,6 +15,7 @@
 #include "../../keyboard/matrix.h"
 #include "../../main.h"
 #include "./public.h"
+#include "./private.h"
 
 /*
  * MediaCodeLookupTable is used to translate from enumeration in keyboard.h to
@@ -49,42 +50,23 @@ void _kbfun_press_release(bool press, uint8_t keycode) {
 	if (keycode == 0)
 		return;
 
-	// modifier keys
-	switch (keycode) {
-		case KEY_LeftControl:  (press)
-				       ? (keyboard_modifier_keys |=  (1<<0))
-				       : (keyboard_modifier_keys &= ~(1<<0));
-				       return;
-		case KEY_LeftShift:    (press)
-				       ? (keyboard_modifier_keys |=  (1<<1))
-				       : (keyboard_modifier_keys &= ~(1<<1));
-				       return;
-		case KEY_LeftAlt:      (press)
-				       ? (keyboard_modifier_keys |=  (1<<2))
-				       : (keyboard_modifier_keys &= ~(1<<2));
-				       return;
-		case KEY_LeftGUI:      (press)
-				       ? (keyboard_modifier_keys |=  (1<<3))
-				       : (keyboard_modifier_keys &= ~(1<<3));
-				       return;
-		case KEY_RightControl: (press)
-				       ? (keyboard_modifier_keys |=  (1<<4))
-				       : (keyboard_modifier_keys &= ~(1<<4));
-				       return;
-		case KEY_RightShift:   (press)
-				       ? (keyboard_modifier_keys |=  (1<<5))
-				       : (keyboard_modifier_keys &= ~(1<<5));
-				       return;
-		case KEY_RightAlt:     (press)
-				       ? (keyboard_modifier_keys |=  (1<<6))
-				       : (keyboard_modifier_keys &= ~(1<<6));
-				       return;
-		case KEY_RightGUI:     (press)
-				       ? (keyboard_modifier_keys |=  (1<<7))
-				       : (keyboard_modifier_keys &= ~(1<<7));
-				       return;
+	// (if a macro's being recorded, it'll want to know)
+	_kbfun_macro_record(press, keycode);
+
+	// modifier keys (contiguous, and in the same order as their bits)
+	if (keycode >= KEY_LeftControl && keycode <= KEY_RightGUI) {
+		uint8_t bit = 1 << (keycode - KEY_LeftControl);
+		if (press)
+			keyboard_modifier_keys |= bit;
+		else
+			keyboard_modifier_keys &= ~bit;
+		return;
 	}
 
+	// (a key pressed uses up the one-shot modifiers)
+	if (press && _kbfun_one_shot_mods)
+		_kbfun_one_shot_use();
+
 	// all others
 	for (uint8_t i=0; i<6; i++) {
 		if (press) {
@@ -106,24 +88,8 @@ void _kbfun_press_release(bool press, uint8_t keycode) {
  */
 bool _kbfun_is_pressed(uint8_t keycode) {
 	// modifier keys
-	switch (keycode) {
-		case KEY_LeftControl:  if (keyboard_modifier_keys & (1<<0))
-					       return true;
-		case KEY_LeftShift:    if (keyboard_modifier_keys & (1<<1))
-					       return true;
-		case KEY_LeftAlt:      if (keyboard_modifier_keys & (1<<2))
-					       return true;
-		case KEY_LeftGUI:      if (keyboard_modifier_keys & (1<<3))
-					       return true;
-		case KEY_RightControl: if (keyboard_modifier_keys & (1<<4))
-					       return true;
-		case KEY_RightShift:   if (keyboard_modifier_keys & (1<<5))
-					       return true;
-		case KEY_RightAlt:     if (keyboard_modifier_keys & (1<<6))
-					       return true;
-		case KEY_RightGUI:     if (keyboard_modifier_keys & (1<<7))
-					       return true;
-	}
+	if (keycode >= KEY_LeftControl && keycode <= KEY_RightGUI)
+		return keyboard_modifier_keys & (1 << (keycode - KEY_LeftControl));
 
 	// all others
 	for (uint8_t i=0; i<6; i++)
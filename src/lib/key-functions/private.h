@@ -16,6 +16,7 @@
 	#include <stdbool.h>
 	#include <stdint.h>
 	#include "../../keyboard/matrix.h"
+	#include "./hooks.h"
 
 	// --------------------------------------------------------------------
 
@@ -23,5 +24,93 @@
 	bool _kbfun_is_pressed        (uint8_t keycode);
 	void _kbfun_mediakey_press_release (bool press, uint8_t keycode);
 
+	// macro player (see "macro.c")
+	void _kbfun_macro_tap   (uint8_t modifiers, uint8_t tap_modifiers,
+	                         uint8_t keycode);
+	void _kbfun_macro_play  (const uint8_t * program);
+	void _kbfun_macro_fence (void);
+
+	// (only if `MAKEFILE_MACRO_RECORD`; see "makefile-options")
+	#if MAKEFILE_MACRO_RECORD
+		void _kbfun_macro_record        (bool press, uint8_t keycode);
+		void _kbfun_macro_record_toggle (void);
+		void _kbfun_macro_replay        (void);
+		void _kbfun_macro_record_save   (void);
+	#else
+		#define  _kbfun_macro_record(press, keycode)
+		#define  _kbfun_macro_record_toggle()
+		#define  _kbfun_macro_replay()
+		#define  _kbfun_macro_record_save()
+	#endif
+
+	// one-shot modifiers and layers (see "one-shot.c")
+	extern uint8_t _kbfun_one_shot_mods;
+
+	void _kbfun_one_shot_press_release (bool press, uint8_t keycode);
+	void _kbfun_one_shot_use           (void);
+	void _kbfun_one_shot_layer         (uint8_t id);
+
+	// unicode characters (see "unicode.c")
+	void _kbfun_unicode_type      (uint32_t code_point);
+	void _kbfun_unicode_mode_next (void);
+
+	// tap-dance keys (see "tap-dance.c")
+	void _kbfun_tap_dance_press   (const uint8_t * keycodes);
+	void _kbfun_tap_dance_release (void);
+
+	// tap-hold keys (see "tap-hold.c")
+	void _kbfun_tap_hold_press   (uint8_t tap_keycode, uint8_t hold,
+	                              uint8_t flags);
+	void _kbfun_tap_hold_release (void);
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * macro programs
+	 *
+	 * A program is a `MACRO_END` terminated array of bytes, in Flash, e.g.
+	 *
+	 *     static const uint8_t PROGMEM arrow[] = {
+	 *         KEY_Dash_Underscore,
+	 *         MACRO_SHIFTED(KEY_Period_GreaterThan),
+	 *         MACRO_END };
+	 *
+	 * - A keycode (anything below `MACRO_DOWN`) taps that key.
+	 * - The user's modifiers aren't sent with a program's keystrokes; only
+	 *   the ones it holds itself (with `MACRO_DOWN`), and the ones wrapped
+	 *   around a single tap (with `MACRO_MODS`).
+	 * - Delays are counted in reports (about one per host polling interval).
+	 * - `MACRO_LAYER_POP` pops the layer pushed by the last
+	 *   `MACRO_LAYER_PUSH`.
+	 * - Any other byte from `MACRO_DOWN` up (i.e. 0xF6..0xFF) isn't an
+	 *   opcode, and ends the program where it is.
+	 */
+
+	#define MACRO_END         0x00
+	#define MACRO_DOWN        0xF0  // + keycode
+	#define MACRO_UP          0xF1  // + keycode
+	#define MACRO_MODS        0xF2  // + modifier bits, keycode to tap
+	#define MACRO_DELAY       0xF3  // + number of reports
+	#define MACRO_LAYER_PUSH  0xF4  // + layer number
+	#define MACRO_LAYER_POP   0xF5
+
+	// modifier bits, as in the modifier byte of a USB report
+	#define MACRO_BIT_SHIFT  (1<<5)  // right shift
+	#define MACRO_BIT_ALTGR  (1<<6)  // right alt
+
+	#define MACRO_SHIFTED(keycode)  MACRO_MODS, MACRO_BIT_SHIFT, (keycode)
+	#define MACRO_ALTGR(keycode)    MACRO_MODS, MACRO_BIT_ALTGR, (keycode)
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * unicode input methods (see "unicode.c")
+	 */
+
+	#define UNICODE_MODE_LINUX       0  // ctrl+shift+u, hex digits, space
+	#define UNICODE_MODE_WINCOMPOSE  1  // compose (right alt), u, hex, enter
+	#define UNICODE_MODE_MACOS       2  // "Unicode Hex Input": alt + hex
+	#define UNICODE_MODES            3
+
 #endif
 
@@ -19,8 +19,12 @@
   void kbfun_press_release (void);
   void kbfun_press_release_preserve_sticky (void);
   void kbfun_toggle        (void);
+  void kbfun_one_shot      (void);
   void kbfun_transparent   (void);
   // --- layer push/pop functions
+  void kbfun_layer_push    (void);
+  void kbfun_layer_sticky  (void);
+  void kbfun_layer_pop     (void);
   void kbfun_layer_push_1  (void);
   void kbfun_layer_push_2  (void);
   void kbfun_layer_push_3  (void);
@@ -51,15 +55,33 @@
   void kbfun_layer_pop_8   (void);
   void kbfun_layer_pop_9   (void);
   void kbfun_layer_pop_10  (void);
+  void kbfun_layer_pop_all (void);
   // ---
 
+  // keymap
+  void kbfun_keymap_next   (void);
+  void kbfun_keymap_select (void);
+
   // device
   void kbfun_jump_to_bootloader (void);
+  void kbfun_profile_dump       (void);
+  void kbfun_chatter_dump       (void);
+  void kbfun_chatter_reset      (void);
+  void kbfun_fault_dump         (void);
+  void kbfun_heatmap_dump       (void);
+  void kbfun_heatmap_reset      (void);
+  void kbfun_stack_dump         (void);
+
+  // tap-hold and tap-dance
+  void kbfun_tap_hold  (void);
+  void kbfun_tap_dance (void);
 
   // special
   void kbfun_altgr_press_release           (void);
   void kbfun_shift_press_release           (void);
   void kbfun_2_keys_capslock_press_release (void);
+  void kbfun_invert_shift_press_release    (void);
+  void kbfun_fix_shifted_press_release     (void);
   void kbfun_layer_push_numpad             (void);
   void kbfun_layer_pop_numpad              (void);
   void kbfun_mediakey_press_release        (void);
@@ -69,14 +91,13 @@
   void kbfun_altgr_u_shifted_press_release (void);
   void kbfun_altgr_n_press_release         (void);
   void kbfun_altgr_n_shifted_press_release (void);
-  void kbfun_arrow_write                   (void);
-  void kbfun_parenthesis_double_quote_write(void);
-  void kbfun_double_quote_parenthesis_write(void);
-  void kbfun_lt2_double_quote_write        (void);
-  void kbfun_double_quote_gt2_write        (void);
-  void kbfun_vim_save                      (void);
-  void kbfun_vim_save_and_quit             (void);
-  void kbfun_vim_buffers                   (void);
+  void kbfun_macro_play                    (void);
+  void kbfun_macro_record                  (void);
+  void kbfun_macro_replay                  (void);
+  void kbfun_macro_record_save             (void);
+  void kbfun_leader                        (void);
+  void kbfun_unicode                       (void);
+  void kbfun_unicode_mode_next             (void);
 
 #endif
 
@@ -14,7 +14,21 @@
 
 // ----------------------------------------------------------------------------
 
-#define  MAX_LAYER_PUSH_POP_FUNCTIONS  10
+// - may be overridden by the layout specific '.h'
+// - the most local ids (see `layer_ids`); by default, one for every layer
+//   but layer 0 (so that `kbfun_layer_push` and the like, which use the
+//   layer number as the local id, work for every layer), and at least one
+//   for each of the numbered functions
+#ifndef MAX_LAYER_PUSH_POP_FUNCTIONS
+	#if KB_LAYERS > 11
+		#define  MAX_LAYER_PUSH_POP_FUNCTIONS  (KB_LAYERS - 1)
+	#else
+		#define  MAX_LAYER_PUSH_POP_FUNCTIONS  10
+	#endif
+#endif
+#if MAX_LAYER_PUSH_POP_FUNCTIONS < 10
+	#error "MAX_LAYER_PUSH_POP_FUNCTIONS must be 10 or more (see `kbfun_layer_push_10`)"
+#endif
 
 // ----------------------------------------------------------------------------
 
@@ -61,6 +75,25 @@ void kbfun_press_release_preserve_sticky(void) {
 	_kbfun_press_release(IS_PRESSED, keycode);
 }
 
+/*
+ * [name]
+ *   One-shot modifier
+ *
+ * [description]
+ *   Hold the modifier given by the keycode while the key is held; or, if the
+ *   key is tapped, for the next key pressed.  Tapping it twice locks it
+ *   (until it's pressed again).
+ *
+ * [note]
+ *   Must be assigned to both the press and the release of the key.  Several
+ *   may be tapped one after another, and all apply to the next key.  See
+ *   "lib/key-functions/one-shot.c" for the timeout.
+ */
+void kbfun_one_shot(void) {
+	uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
+	_kbfun_one_shot_press_release(IS_PRESSED, keycode);
+}
+
 /*
  * [name]
  *   Toggle
@@ -88,8 +121,8 @@ void kbfun_toggle(void) {
 void kbfun_transparent(void) {
 	main_arg_trans_key_pressed = true;
 	LAYER_OFFSET++;
-	LAYER = main_layers_peek(LAYER_OFFSET);
-	main_layers_pressed[ROW][COL] = LAYER;
+	LAYER = main_layers_peek_layout(LAYER_OFFSET);
+	main_layers_pressed_set(ROW, COL, LAYER);
 	main_exec_key();
 }
 
@@ -98,9 +131,12 @@ void kbfun_transparent(void) {
  * layer push/pop functions
  * ------------------------------------------------------------------------- */
 
-// While there are only MAX_LAYER_PUSH_POP_FUNCTIONS number of layer functions,
-//  there are 1 + MAX_LAYER_PUSH_POP_FUNCTIONS layer ids because we still have
-//  layer 0 even if we will never have a push or pop function for it
+// While there are only MAX_LAYER_PUSH_POP_FUNCTIONS local ids, there are
+//  1 + MAX_LAYER_PUSH_POP_FUNCTIONS layer ids because we still have layer 0
+//  even if we will never have a push or pop function for it
+// The numbered functions use their number as the local id; the unnumbered
+//  ones (`kbfun_layer_push` and the like) use the layer number, so e.g.
+//  `kbfun_layer_push_3` and `kbfun_layer_push` to layer 3 are the same pair
 static uint8_t layer_ids[1 + MAX_LAYER_PUSH_POP_FUNCTIONS];
 
 static void layer_push(uint8_t local_id) {
@@ -110,7 +146,7 @@ static void layer_push(uint8_t local_id) {
 	//  the top layer if it is in sticky once state
 	uint8_t topSticky = main_layers_peek_sticky(0);
 	if (topSticky == eStickyOnceDown || topSticky == eStickyOnceUp) {
-		main_layers_pop_id(main_layers_peek(0));
+		main_layers_pop_id(main_layers_peek_id(0));
 	}
 	layer_ids[local_id] = main_layers_push(keycode, eStickyNone);
 }
@@ -129,7 +165,7 @@ static void layer_sticky(uint8_t local_id) {
 		{
 			// only the topmost layer on the stack should be in sticky once state
 			if (topSticky == eStickyOnceDown || topSticky == eStickyOnceUp) {
-				main_layers_pop_id(layer_ids[topLayer]);
+				main_layers_pop_id(main_layers_peek_id(0));
 			}
 			layer_ids[local_id] = main_layers_push(keycode, eStickyOnceDown);
 			// this should be the only place we care about this flag being cleared
@@ -149,6 +185,7 @@ static void layer_sticky(uint8_t local_id) {
 					//  was pressed, push the layer again, but in the
 					//  StickyOnceUp state
 					layer_ids[local_id] = main_layers_push(keycode, eStickyOnceUp);
+					_kbfun_one_shot_layer(layer_ids[local_id]);
 				}
 			}
 		}
@@ -160,6 +197,66 @@ static void layer_pop(uint8_t local_id) {
 	layer_ids[local_id] = 0;
 }
 
+/*
+ * Get the layer number given by the keycode, as a local id (0, which no
+ * function uses, if it's out of range)
+ */
+static uint8_t layer_local_id(void) {
+	uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
+	return (keycode <= MAX_LAYER_PUSH_POP_FUNCTIONS) ? keycode : 0;
+}
+
+/*
+ * Forget the ids of the layers pushed (they've all been popped, by
+ * `main_keymap_select()`)
+ */
+void _kbfun_layer_reset(void) {
+	for (uint8_t i=0; i<=MAX_LAYER_PUSH_POP_FUNCTIONS; i++)
+		layer_ids[i] = 0;
+}
+
+/*
+ * [name]
+ *   Layer push
+ *
+ * [description]
+ *   Push a layer element containing the layer value specified in the keymap to
+ *   the top of the stack, and record the id of that layer element (under the
+ *   layer number; so this works for any layer, not just the first 10)
+ */
+void kbfun_layer_push(void) {
+	uint8_t local_id = layer_local_id();
+	if (local_id)
+		layer_push(local_id);
+}
+
+/*
+ * [name]
+ *   Layer sticky cycle
+ *
+ * [description]
+ *   As "Layer sticky cycle #1" (below), for the layer specified in the keymap
+ */
+void kbfun_layer_sticky(void) {
+	uint8_t local_id = layer_local_id();
+	if (local_id)
+		layer_sticky(local_id);
+}
+
+/*
+ * [name]
+ *   Layer pop
+ *
+ * [description]
+ *   Pop the layer element created by "Layer push" (or "Layer sticky cycle")
+ *   for the layer specified in the keymap
+ */
+void kbfun_layer_pop(void) {
+	uint8_t local_id = layer_local_id();
+	if (local_id)
+		layer_pop(local_id);
+}
+
 /*
  * [name]
  *   Layer push #1
@@ -548,6 +645,19 @@ void kbfun_layer_pop_10(void) {
 	layer_pop(10);
 }
 
+/*
+ * [name]
+ *   Layer pop all
+ *
+ * [description]
+ *   Pop all the layer elements created by the "layer push" functions out of
+ *   the layer stack
+ */
+void kbfun_layer_pop_all(void) {
+	for (uint8_t local_id=1; local_id<=MAX_LAYER_PUSH_POP_FUNCTIONS; local_id++)
+		layer_pop(local_id);
+}
+
 /* ----------------------------------------------------------------------------
  * ------------------------------------------------------------------------- */
 
@@ -7,9 +7,21 @@
  * ------------------------------------------------------------------------- */
 
 
+#include <stdint.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 #include <util/delay.h>
+#include "../../../lib/chatter.h"
+#include "../../../lib/debug.h"
+#include "../../../lib/fault.h"
+#include "../../../lib/heatmap.h"
+#include "../../../lib/profile.h"
+#include "../../../lib/stack.h"
+#include "../../../lib/usb/usage-page/keyboard.h"
+#include "../../../keyboard/matrix.h"
+#include "../../../main.h"
 #include "../public.h"
+#include "../private.h"
 
 
 // ----------------------------------------------------------------------------
@@ -25,6 +37,127 @@
  */
 void kbfun_jump_to_bootloader(void);
 
+/*
+ * [name]
+ *   Profile dump
+ *
+ * [description]
+ *   Type out how long each stage of the main loop has taken (minimum,
+ *   average, and maximum, in microseconds) since the last dump, and start
+ *   counting again; then how long after reset the host configured the
+ *   keyboard, and the first key press was sent (in milliseconds).  With the
+ *   debug console (`DEBUG := 1`), print it there instead
+ *
+ * [note]
+ *   Does nothing unless the firmware was built with `PROFILE := 1` (see
+ *   "makefile-options")
+ */
+void kbfun_profile_dump(void);
+
+/*
+ * [name]
+ *   Chatter dump
+ *
+ * [description]
+ *   Type out the row, column, and bounce count of each key that has bounced
+ *   (see "lib/chatter.h").  With the debug console (`DEBUG := 1`), print it
+ *   there instead
+ */
+void kbfun_chatter_dump(void);
+
+/*
+ * [name]
+ *   Chatter reset
+ *
+ * [description]
+ *   Forget the bounce counts (so that keys debounced more slowly, for
+ *   chattering, aren't any more)
+ */
+void kbfun_chatter_reset(void);
+
+/*
+ * [name]
+ *   Fault dump
+ *
+ * [description]
+ *   Type out how many ghosts, shorts, stuck keys, and bridged pairs of rows
+ *   have been seen (see "lib/fault.h"); then the row and column of each key
+ *   being ignored as stuck.  With the debug console (`DEBUG := 1`), print it
+ *   there instead
+ */
+void kbfun_fault_dump(void);
+
+/*
+ * [name]
+ *   Heatmap dump
+ *
+ * [description]
+ *   Type out the row, column, and press count of each key that has been
+ *   pressed (see "lib/heatmap.h").  With the debug console (`DEBUG := 1`),
+ *   print it there instead.  Either way, the output (saved to a file) can be
+ *   drawn over the layout by "build-scripts/gen-layout.py", with
+ *   `--heatmap-file`
+ *
+ * [note]
+ *   Does nothing unless the firmware was built with `HEATMAP := 1` (see
+ *   "makefile-options")
+ */
+void kbfun_heatmap_dump(void);
+
+/*
+ * [name]
+ *   Heatmap reset
+ *
+ * [description]
+ *   Forget the press counts (in the EEPROM too, with the next save)
+ */
+void kbfun_heatmap_reset(void);
+
+/*
+ * [name]
+ *   Stack dump
+ *
+ * [description]
+ *   Type out the most SRAM the stack has used since reset, and how much it
+ *   has never reached (in bytes; see "lib/stack.h").  With the debug console
+ *   (`DEBUG := 1`), print it there instead
+ */
+void kbfun_stack_dump(void);
+
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+// (for typing out the dumps, when there's no debug console)
+#if !MAKEFILE_DEBUG
+
+static void type_char(char c) {
+	uint8_t keycode = (c >= 'a' && c <= 'z') ? KEY_a_A + (c - 'a')
+	                : (c >= '1' && c <= '9') ? KEY_1_Exclamation + (c - '1')
+	                : (c == '0')             ? KEY_0_RightParenthesis
+	                : (c == '\n')            ? KEY_ReturnEnter
+	                :                          KEY_Spacebar;
+
+	_kbfun_macro_tap(0, 0, keycode);
+}
+
+static void type_number(uint32_t number) {
+	char digits[10];
+	uint8_t count = 0;
+
+	do {
+		digits[count++] = '0' + (number % 10);
+		number /= 10;
+	} while (number);
+
+	type_char(' ');
+	while (count)
+		type_char(digits[--count]);
+}
+
+#endif
+
 
 // ----------------------------------------------------------------------------
 #if MAKEFILE_BOARD == teensy-2-0
@@ -65,3 +198,208 @@ void kbfun_jump_to_bootloader(void) {}
 #endif
 // ----------------------------------------------------------------------------
 
+
+// ----------------------------------------------------------------------------
+#if MAKEFILE_PROFILE
+// ----------------------------------------------------------------------------
+
+// in the order of `PROFILE_*` (see "lib/profile.h")
+static const char PROGMEM profile_names[PROFILE_STAGES][10] = {
+	"teensy", "mcp23018", "dispatch", "usb", "usb extra",
+	"debounce", "leds", "wake", "loop" };
+
+// - to the debug console, if there is one (see "lib/debug.h")
+// - else typed (which blocks, once the macro player's queue is full; but the
+//   counts are reset afterwards, so that doesn't show)
+void kbfun_profile_dump(void) {
+	for (uint8_t stage=0; stage<PROFILE_STAGES; stage++) {
+		uint16_t min, max, count;
+		uint32_t total;
+		profile_get(stage, &min, &max, &total, &count);
+
+		#if MAKEFILE_DEBUG
+			if (count)
+				dprintf( "%S %u %lu %u\n", profile_names[stage],
+				         (uint16_t)(min / PROFILE_TICKS_PER_US),
+				         total / count / PROFILE_TICKS_PER_US,
+				         (uint16_t)(max / PROFILE_TICKS_PER_US) );
+			debug_drain();
+		#else
+			for (const char * c = profile_names[stage]; pgm_read_byte(c); c++)
+				type_char(pgm_read_byte(c));
+			if (count) {
+				type_number(min / PROFILE_TICKS_PER_US);
+				type_number(total / count / PROFILE_TICKS_PER_US);
+				type_number(max / PROFILE_TICKS_PER_US);
+			}
+			type_char('\n');
+		#endif
+	}
+
+	#if MAKEFILE_DEBUG
+		dprintf("boot %u %u\n", main_boot_usb_ms, main_boot_first_key_ms);
+		debug_drain();
+	#else
+		for (const char * c = PSTR("boot"); pgm_read_byte(c); c++)
+			type_char(pgm_read_byte(c));
+		type_number(main_boot_usb_ms);
+		type_number(main_boot_first_key_ms);
+		type_char('\n');
+	#endif
+
+	profile_reset();
+}
+
+
+// ----------------------------------------------------------------------------
+#else
+// ----------------------------------------------------------------------------
+
+void kbfun_profile_dump(void) {}
+
+
+// ----------------------------------------------------------------------------
+#endif
+// ----------------------------------------------------------------------------
+
+
+// ----------------------------------------------------------------------------
+#if MAKEFILE_CHATTER
+// ----------------------------------------------------------------------------
+
+// - to the debug console, if there is one (see "lib/debug.h")
+// - else typed (one line per key: row, column, count)
+void kbfun_chatter_dump(void) {
+	for (uint8_t row=0; row<KB_ROWS; row++) {
+		for (uint8_t col=0; col<KB_COLUMNS; col++) {
+			uint8_t count = chatter_count(row, col);
+			if (!count)
+				continue;
+
+			#if MAKEFILE_DEBUG
+				dprintf("chatter %u %u %u\n", row, col, count);
+				debug_drain();
+			#else
+				type_number(row);
+				type_number(col);
+				type_number(count);
+				type_char('\n');
+			#endif
+		}
+	}
+}
+
+void kbfun_chatter_reset(void) {
+	chatter_reset();
+}
+
+
+// ----------------------------------------------------------------------------
+#else
+// ----------------------------------------------------------------------------
+
+void kbfun_chatter_dump(void) {}
+void kbfun_chatter_reset(void) {}
+
+
+// ----------------------------------------------------------------------------
+#endif
+// ----------------------------------------------------------------------------
+
+
+// ----------------------------------------------------------------------------
+
+// - to the debug console, if there is one (see "lib/debug.h")
+// - else typed (a line of counts: ghosts, shorts, stuck keys, bridges; then
+//   one line per stuck key: "stuck", row, column)
+void kbfun_fault_dump(void) {
+	#if MAKEFILE_DEBUG
+		dprintf( "fault %u %u %u %u\n", fault_count(FAULT_GHOST),
+		         fault_count(FAULT_SHORT), fault_count(FAULT_STUCK),
+		         fault_count(FAULT_BRIDGE) );
+		debug_drain();
+	#else
+		for (uint8_t type=0; type<FAULT_TYPES; type++)
+			type_number(fault_count(type));
+		type_char('\n');
+	#endif
+
+	for (uint8_t row=0; row<KB_ROWS; row++) {
+		for (uint8_t col=0; col<KB_COLUMNS; col++) {
+			if (!fault_stuck(row, col))
+				continue;
+
+			#if MAKEFILE_DEBUG
+				dprintf("stuck %u %u\n", row, col);
+				debug_drain();
+			#else
+				for (const char * c = PSTR("stuck"); pgm_read_byte(c); c++)
+					type_char(pgm_read_byte(c));
+				type_number(row);
+				type_number(col);
+				type_char('\n');
+			#endif
+		}
+	}
+}
+
+
+// ----------------------------------------------------------------------------
+#if MAKEFILE_HEATMAP
+// ----------------------------------------------------------------------------
+
+// - to the debug console, if there is one (see "lib/debug.h")
+// - else typed (one line per key: row, column, count)
+void kbfun_heatmap_dump(void) {
+	for (uint8_t row=0; row<KB_ROWS; row++) {
+		for (uint8_t col=0; col<KB_COLUMNS; col++) {
+			uint16_t count = heatmap_get(row, col);
+			if (!count)
+				continue;
+
+			#if MAKEFILE_DEBUG
+				dprintf("heatmap %u %u %u\n", row, col, count);
+				debug_drain();
+			#else
+				type_number(row);
+				type_number(col);
+				type_number(count);
+				type_char('\n');
+			#endif
+		}
+	}
+}
+
+void kbfun_heatmap_reset(void) {
+	heatmap_reset();
+}
+
+
+// ----------------------------------------------------------------------------
+#else
+// ----------------------------------------------------------------------------
+
+void kbfun_heatmap_dump(void) {}
+void kbfun_heatmap_reset(void) {}
+
+
+// ----------------------------------------------------------------------------
+#endif
+// ----------------------------------------------------------------------------
+
+
+// ----------------------------------------------------------------------------
+
+// - to the debug console, if there is one (see "lib/debug.h")
+// - else typed
+void kbfun_stack_dump(void) {
+	#if MAKEFILE_DEBUG
+		dprintf("stack %u %u\n", stack_used(), stack_unused());
+	#else
+		type_char('s');
+		type_number(stack_used());
+		type_number(stack_unused());
+		type_char('\n');
+	#endif
+}
+
@@ -0,0 +1,56 @@
+/* ----------------------------------------------------------------------------
+ * key functions : keymap switching : code
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include "../../../main.h"
+#include "../../../keyboard/layout.h"
+#include "../public.h"
+
+// ----------------------------------------------------------------------------
+
+// convenience macros
+#define  LAYER       main_arg_layer
+#define  ROW         main_arg_row
+#define  COL         main_arg_col
+#define  IS_PRESSED  main_arg_is_pressed
+
+// ----------------------------------------------------------------------------
+
+/*
+ * [name]
+ *   Keymap next
+ *
+ * [description]
+ *   Make the next keymap linked into the firmware active (wrapping around
+ *   after the last)
+ *
+ * [note]
+ *   Does nothing unless several keymaps are linked in (see `KEYMAPS` in
+ *   "makefile-options")
+ */
+void kbfun_keymap_next(void) {
+	if (IS_PRESSED)
+		main_keymap_select( (main_keymap+1 < KB_KEYMAPS) ? main_keymap+1 : 0 );
+}
+
+/*
+ * [name]
+ *   Keymap select
+ *
+ * [description]
+ *   Make the keymap given by the keycode (0 for the first) active
+ *
+ * [note]
+ *   Does nothing unless several keymaps are linked in (see `KEYMAPS` in
+ *   "makefile-options")
+ */
+void kbfun_keymap_select(void) {
+	if (IS_PRESSED)
+		main_keymap_select(kb_layout_get(LAYER, ROW, COL));
+}
+
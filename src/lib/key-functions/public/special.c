@@ -9,13 +9,13 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <avr/pgmspace.h>
 #include "../../../lib-other/pjrc/usb_keyboard/usb_keyboard.h"
 #include "../../../lib/usb/usage-page/keyboard.h"
 #include "../../../keyboard/layout.h"
 #include "../../../main.h"
 #include "../public.h"
 #include "../private.h"
-#include <util/delay.h>
 
 // ----------------------------------------------------------------------------
 
@@ -111,12 +111,117 @@ void kbfun_2_keys_capslock_press_release(void) {
   if (IS_PRESSED) keys_pressed++;
 }
 
+/* ----------------------------------------------------------------------------
+ * inverted shift functions (for keys that are shifted unless shift is held,
+ * like the number row of Workman-P)
+ * ------------------------------------------------------------------------- */
+
+// TODO: there is a bug where if you hit an inverted key and a normal key, at
+// the same time, when the 6 key buffer and modifier states are sent the
+// inverted key's shift state can be used for the non-inverted key.
+// Example: hit 1 and q at the same time in workman-p, you may end up with "!Q"
+// instead of "!q".  Not sure how to fix this at present, but it may require
+// sending two frames of updates to properly denote an order (shifted in one
+// update, unshifted added in another, as though shift was released).
+
+static uint8_t inverted_keys_pressed;
+static bool physical_lshift_pressed;
+static bool physical_rshift_pressed;
+
+static void invert_shift_state(void) {
+  // make lshift's state the inverted shift stated
+  _kbfun_press_release(!(physical_lshift_pressed|physical_rshift_pressed), KEY_LeftShift);
+  // release rshift
+  _kbfun_press_release(false, KEY_RightShift);
+}
+static void restore_shift_state(void) {
+  // restore the state of left and right shift
+  _kbfun_press_release(physical_lshift_pressed, KEY_LeftShift);
+  _kbfun_press_release(physical_rshift_pressed, KEY_RightShift);
+}
+
+/*
+ * [name]
+ *   Invert shift + press|release
+ *
+ * [description]
+ *   Generate a 'shift' press or release before the normal keypress or
+ *   key release if shift is not pressed.  Generate a normal keypress or
+ *   key release if shift is pressed.
+ */
+void kbfun_invert_shift_press_release(void) {
+  if (IS_PRESSED) {
+    ++inverted_keys_pressed;
+    invert_shift_state();
+  }
+
+  kbfun_press_release();
+
+  if (!IS_PRESSED) {
+    // if this is the last key we're releasing
+    if (inverted_keys_pressed == 1) {
+      restore_shift_state();
+    }
+    // avoid underflow
+    if (inverted_keys_pressed) {
+      --inverted_keys_pressed;
+    }
+  }
+}
+
+/*
+ * [name]
+ *   Shift state fix + press|release
+ *
+ * [description]
+ *   If no inverted keys are pressed, simply perform a press and release.
+ *   If inverted keys are pressed, fix the shift state back to that of the
+ *   physical keys before pressing the key.
+ */
+void kbfun_fix_shifted_press_release(void) {
+  uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
+  switch (keycode) {
+    // shift state toggles
+    case KEY_LeftShift:
+      physical_lshift_pressed = IS_PRESSED;
+      break;
+    case KEY_RightShift:
+      physical_rshift_pressed = IS_PRESSED;
+      break;
+    // Keys which don't break it
+    case KEY_CapsLock:
+    case KEYPAD_NumLock_Clear:
+      kbfun_press_release();
+      return;
+    default:
+      // If we're not just changing the modifier, we need our true shift state.
+      if (inverted_keys_pressed) {
+        inverted_keys_pressed = 0;
+        restore_shift_state();
+      }
+      kbfun_press_release();
+      return;
+  }
+  // We only get here if we pressed left or right shift
+  if (inverted_keys_pressed) {
+    invert_shift_state();
+  } else {
+    kbfun_press_release();
+  }
+}
+
 /* ----------------------------------------------------------------------------
  * numpad functions
  * ------------------------------------------------------------------------- */
 
 static uint8_t numpad_layer_id;
 
+// forget the id of the numpad layer (it's been popped, by
+// `main_keymap_select()`)
+void _kbfun_numpad_reset(void) {
+  numpad_layer_id = 0;
+}
+
 static inline void numpad_toggle_numlock(void) {
   _kbfun_press_release(true, KEY_LockingNumLock);
   usb_keyboard_send();
@@ -186,32 +291,40 @@ void kbfun_mediakey_press_release(void) {
  * symbol functions
  * ------------------------------------------------------------------------- */
 
-
 /*
- * [name]
- *   AltGr + e + press|release
- *
- * [description]
- *   Generate a 'AltGr + e' (acute accent) press and release before the normal keypress or
- *   keyrelease
+ * Tap AltGr + `dead_keycode` (a dead key, without the user's shifts), and
+ * then the key's keycode (shifted, or not)
  */
-void kbfun_altgr_e_press_release(void) {
-
+static void altgr_dead_key(uint8_t dead_keycode, bool shifted) {
   uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
 
   /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
+  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift);
+  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift);
   _kbfun_press_release(false, KEY_RightShift);
   _kbfun_press_release(false, KEY_LeftShift);
 
-  write_alted_code(KEY_e_E);
+  write_alted_code(dead_keycode);
 
   _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
   _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
- 
-  write_code(keycode);
 
+  if (shifted)
+    write_shifted_code(keycode);
+  else
+    write_code(keycode);
+}
+
+/*
+ * [name]
+ *   AltGr + e + press|release
+ *
+ * [description]
+ *   Generate a 'AltGr + e' (acute accent) press and release before the normal keypress or
+ *   keyrelease
+ */
+void kbfun_altgr_e_press_release(void) {
+  altgr_dead_key(KEY_e_E, false);
 }
 
 /*
@@ -223,22 +336,7 @@ void kbfun_altgr_e_press_release(void) {
  *   keyrelease
  */
 void kbfun_altgr_e_shifted_press_release(void) {
-
-  uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
-
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  write_alted_code(KEY_e_E);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
- 
-  write_shifted_code(keycode);
-
+  altgr_dead_key(KEY_e_E, true);
 }
 
 /*
@@ -250,22 +348,7 @@ void kbfun_altgr_e_shifted_press_release(void) {
  *   keyrelease
  */
 void kbfun_altgr_u_press_release(void) {
-
-  uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
-
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  write_alted_code(KEY_u_U);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
- 
-  write_code(keycode);
-
+  altgr_dead_key(KEY_u_U, false);
 }
 
 /*
@@ -277,27 +360,9 @@ void kbfun_altgr_u_press_release(void) {
  *   keyrelease
  */
 void kbfun_altgr_u_shifted_press_release(void) {
-
-  uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
-
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  write_alted_code(KEY_u_U);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
- 
-  write_shifted_code(keycode);
-
+  altgr_dead_key(KEY_u_U, true);
 }
 
-
-
-
 /*
  * [name]
  *   AltGr + n + press|release
@@ -307,26 +372,9 @@ void kbfun_altgr_u_shifted_press_release(void) {
  *   keyrelease
  */
 void kbfun_altgr_n_press_release(void) {
-
-  uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
-
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  write_alted_code(KEY_n_N);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
-
-  write_code(keycode);
-
-
+  altgr_dead_key(KEY_n_N, false);
 }
 
-
 /*
  * [name]
  *   AltGr + n + Shift & press|release
@@ -336,271 +384,139 @@ void kbfun_altgr_n_press_release(void) {
  *   keyrelease
  */
 void kbfun_altgr_n_shifted_press_release(void) {
-
-  uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
-
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  write_alted_code(KEY_n_N);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
- 
-  write_shifted_code(keycode);
-
+  altgr_dead_key(KEY_n_N, true);
 }
 
-
-
-
 /* ----------------------------------------------------------------------------
- * macro functions
+ * unicode functions
  * ------------------------------------------------------------------------- */
 
 /*
  * [name]
- *   '->' write 
+ *   Unicode
  *
  * [description]
- *   Writes the string '->' 
- */
-void kbfun_arrow_write(void) {
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  // '-'
-  write_code(KEY_Dash_Underscore);
-  // '>'
-  write_shifted_code(KEY_Period_GreaterThan);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
-}
-
-/*
- * [name]
- *   '("' write 
+ *   Type the code point whose index (into the layout's
+ *   `_kb_layout_unicode[]`, see "default--matrix-control.h") is given by the
+ *   keycode, the way the host's input method expects
  *
- * [description]
- *   Writes the string '("' 
+ * [note]
+ *   The keystrokes are queued, so typing doesn't pause the scan
  */
-void kbfun_parenthesis_double_quote_write(void) {
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  // '('
-  write_shifted_code(KEY_9_LeftParenthesis);
-  // '"'
-  write_shifted_code(KEY_SingleQuote_DoubleQuote);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
+void kbfun_unicode(void) {
+  if (IS_PRESSED)
+    _kbfun_unicode_type(
+        kb_layout_unicode_get(kb_layout_get(LAYER, ROW, COL)) );
 }
 
 /*
  * [name]
- *   '")' write 
+ *   Unicode input method
  *
  * [description]
- *   Writes the string '")' 
+ *   Switch to the next host input method for unicode characters (Linux,
+ *   WinCompose, macOS), and save the choice to the EEPROM
  */
-void kbfun_double_quote_parenthesis_write(void) {
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  // '"'
-  write_shifted_code(KEY_SingleQuote_DoubleQuote);
-  // ')'
-  write_shifted_code(KEY_0_RightParenthesis);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
+void kbfun_unicode_mode_next(void) {
+  if (IS_PRESSED)
+    _kbfun_unicode_mode_next();
 }
 
+/* ----------------------------------------------------------------------------
+ * macro functions
+ * ----------------------------------------------------------------------------
+ * Each of these plays a macro program (see "../private.h"), so a new one
+ * costs only its bytes and a two line function.
+ * ------------------------------------------------------------------------- */
 
 /*
  * [name]
- *   '<<"' write 
+ *   Macro
  *
  * [description]
- *   Writes the string '<<"' 
+ *   Play the macro whose index (into the layout's `_kb_layout_macros[]`, see
+ *   "default--matrix-control.h") is given by the keycode
  */
-void kbfun_lt2_double_quote_write(void) {
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  // '<'
-  write_shifted_code(KEY_Comma_LessThan);
-  // '<'
-  write_shifted_code(KEY_Comma_LessThan);
-  // '"'
-  write_shifted_code(KEY_SingleQuote_DoubleQuote);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
+void kbfun_macro_play(void) {
+  _kbfun_macro_play(kb_layout_macro_get(kb_layout_get(LAYER, ROW, COL)));
 }
 
 /*
  * [name]
- *   '">>' write 
+ *   Leader
  *
  * [description]
- *   Writes the string '">>' 
+ *   Start a leader sequence: the next few keys typed choose a macro to play
+ *   (see the layout's `_kb_layout_leader`), instead of being sent
  */
-void kbfun_double_quote_gt2_write(void) {
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  // '"'
-  write_shifted_code(KEY_SingleQuote_DoubleQuote);
-  // '>'
-  write_shifted_code(KEY_Period_GreaterThan);
-  // '>'
-  write_shifted_code(KEY_Period_GreaterThan);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
+void kbfun_leader(void) {
+  if (IS_PRESSED)
+    _kbfun_leader_start();
 }
 
-
-
 /*
  * [name]
- *   vim save ':w'
+ *   Macro record
  *
  * [description]
- *   Writes the string ':w' 
+ *   Start recording keystrokes into a macro, or (if recording) stop
+ *
+ * [note]
+ *   The keys are recorded as they're sent, after layers have been resolved.
+ *   Recording stops by itself after about 15 keystrokes.  Does nothing
+ *   unless the firmware was built with `MACRO_RECORD := 1` (see
+ *   "makefile-options"); nor do the two below.
  */
-void kbfun_vim_save(void) {
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  // ':'
-  write_shifted_code(KEY_Semicolon_Colon);
-  // 'w'
-  write_code(KEY_w_W);
-  // 'Enter'
-  write_code(KEY_ReturnEnter);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
+void kbfun_macro_record(void) {
+  if (IS_PRESSED)
+    _kbfun_macro_record_toggle();
 }
 
 /*
  * [name]
- *   vim save and quit ':wq'
+ *   Macro replay
  *
  * [description]
- *   Writes the string ':w' 
+ *   Replay the recorded macro (or, if nothing has been recorded since the
+ *   keyboard was plugged in, the saved one)
  */
-void kbfun_vim_save_and_quit(void) {
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  // ':'
-  write_shifted_code(KEY_Semicolon_Colon);
-  // 'wq'
-  write_code(KEY_w_W);
-  write_code(KEY_q_Q);
-  // 'Enter'
-  write_code(KEY_ReturnEnter);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
+void kbfun_macro_replay(void) {
+  if (IS_PRESSED)
+    _kbfun_macro_replay();
 }
 
 /*
  * [name]
- *   vim buffers ':b [Tab]'
+ *   Macro save
  *
  * [description]
- *   Writes the string ':b [Tab]' 
+ *   Save the recorded macro to the EEPROM
  */
-void kbfun_vim_buffers(void) {
-  /* Remember old state of shift before disabling it */
-  bool right_shift_was_pressed = _kbfun_is_pressed(KEY_RightShift); 
-  bool left_shift_was_pressed = _kbfun_is_pressed(KEY_LeftShift); 
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, KEY_LeftShift);
-
-  // ':'
-  write_shifted_code(KEY_Semicolon_Colon);
-  // 'b ' 
-  write_code(KEY_b_B);
-  write_code(KEY_Spacebar);
-  // [Tab]
-  write_code(KEY_Tab);
-
-  _kbfun_press_release(right_shift_was_pressed, KEY_RightShift);
-  _kbfun_press_release(left_shift_was_pressed, KEY_LeftShift);
+void kbfun_macro_record_save(void) {
+  if (IS_PRESSED)
+    _kbfun_macro_record_save();
 }
 
 /* ----------------------------------------------------------------------------
  * private utility functions
  * ------------------------------------------------------------------------- */
+// - these queue the keystroke for the macro player (see "../macro.c"),
+//   with the modifiers as they are now, and return immediately
 void write_code(uint8_t keycode) {
-  _kbfun_press_release(true, keycode);
-  usb_keyboard_send();
-  _delay_ms(MAKEFILE_DEBOUNCE_TIME);
-
-  _kbfun_press_release(false, keycode);
-  usb_keyboard_send();
-  _delay_ms(MAKEFILE_DEBOUNCE_TIME);
+  _kbfun_macro_tap(keyboard_modifier_keys, 0, keycode);
 }
 
 void write_shifted_code(uint8_t keycode) {
-  _kbfun_press_release(true, KEY_RightShift);
-  _kbfun_press_release(true, keycode);
-  usb_keyboard_send();
-  _delay_ms(MAKEFILE_DEBOUNCE_TIME);
-
-  _kbfun_press_release(false, KEY_RightShift);
-  _kbfun_press_release(false, keycode);
-  usb_keyboard_send();
-  _delay_ms(MAKEFILE_DEBOUNCE_TIME);
+  _kbfun_macro_tap(keyboard_modifier_keys, MACRO_BIT_SHIFT, keycode);
 }
 
 void write_alted_code(uint8_t keycode) {
-  _kbfun_press_release(true, KEY_RightAlt);
-  _kbfun_press_release(true, keycode);
-  usb_keyboard_send();
-  _delay_ms(MAKEFILE_DEBOUNCE_TIME);
-
-  _kbfun_press_release(false, KEY_RightAlt);
-  _kbfun_press_release(false, keycode);
-  usb_keyboard_send();
-  _delay_ms(MAKEFILE_DEBOUNCE_TIME);
+  _kbfun_macro_tap(keyboard_modifier_keys, MACRO_BIT_ALTGR, keycode);
 }
 
 
 
 
-
 /* ----------------------------------------------------------------------------
  * ------------------------------------------------------------------------- */
 
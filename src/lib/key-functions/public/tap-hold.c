@@ -0,0 +1,72 @@
+/* ----------------------------------------------------------------------------
+ * key functions : tap-hold and tap-dance keys : code
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include "../../../main.h"
+#include "../../../keyboard/layout.h"
+#include "../public.h"
+#include "../private.h"
+
+// ----------------------------------------------------------------------------
+
+// convenience macros
+#define  LAYER       main_arg_layer
+#define  ROW         main_arg_row
+#define  COL         main_arg_col
+#define  IS_PRESSED  main_arg_is_pressed
+
+// ----------------------------------------------------------------------------
+
+/*
+ * [name]
+ *   Tap-hold
+ *
+ * [description]
+ *   Tap for one keycode; hold for another (e.g. a modifier), or for a layer.
+ *   The keycode is the index of the key's entry in the layout's
+ *   `_kb_layout_tap_holds[]` (see "default--matrix-control.h")
+ *
+ * [note]
+ *   Must be assigned to both the press and the release of the key
+ */
+void kbfun_tap_hold(void) {
+	if (IS_PRESSED) {
+		uint8_t index = kb_layout_get(LAYER, ROW, COL);
+		_kbfun_tap_hold_press(
+				kb_layout_tap_hold_get(index, KB_TAP_HOLD_TAP),
+				kb_layout_tap_hold_get(index, KB_TAP_HOLD_HOLD),
+				kb_layout_tap_hold_get(index, KB_TAP_HOLD_FLAGS) );
+	} else {
+		_kbfun_tap_hold_release();
+	}
+}
+
+
+/*
+ * [name]
+ *   Tap-dance
+ *
+ * [description]
+ *   Tap once, twice, or three times, hold, or tap and then hold, for
+ *   different keycodes.  The keycode is the index of the key's entry in the
+ *   layout's `_kb_layout_tap_dances[]` (see "default--matrix-control.h")
+ *
+ * [note]
+ *   Must be assigned to both the press and the release of the key
+ */
+void kbfun_tap_dance(void) {
+	if (IS_PRESSED) {
+		uint8_t index = kb_layout_get(LAYER, ROW, COL);
+		uint8_t keycodes[5];
+		for (uint8_t i=0; i<5; i++)
+			keycodes[i] = kb_layout_tap_dance_get(index, i);
+		_kbfun_tap_dance_press(keycodes);
+	} else {
+		_kbfun_tap_dance_release();
+	}
+}
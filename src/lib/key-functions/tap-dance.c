@@ -0,0 +1,198 @@
+/* ----------------------------------------------------------------------------
+ * key functions : tap-dance keys : code
+ *
+ * A tap-dance key does one thing when tapped once, another when tapped twice
+ * (or three times), another when held, and another when tapped and then held
+ * (see "default--matrix-control.h").  The taps are counted as they happen,
+ * against `timer_ms()`, and nothing ever waits with `_delay_ms()`.
+ *
+ * The key decides as soon as the count can't change what it does any more:
+ * - released, when no more taps (or tap and hold) would mean anything else:
+ *   the tap's keycode is tapped at once
+ * - pressed, when it couldn't mean anything else either: the tap's keycode
+ *   is pressed, and held until the key is released
+ * - down for `KB_TAPPING_TERM`: the hold's keycode (if there is one; else
+ *   the tap's) is pressed, and held until the key is released
+ * - up for `KB_TAPPING_TERM`: the tap's keycode is tapped
+ * - another key pressed: as if the term had run out, just before that key
+ *
+ * Other keys are held back only by the last case, when it taps: their event
+ * waits (in the matrix; see `main_key_event()`) until the tap has been sent,
+ * lest both go out in the same report.  The scan goes on meanwhile.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../lib-other/pjrc/usb_keyboard/usb_keyboard.h"
+#include "../../lib/timer.h"
+#include "../../keyboard/layout.h"
+#include "../../keyboard/matrix.h"
+#include "../../main.h"
+#include "./private.h"
+
+// ----------------------------------------------------------------------------
+
+// the key being counted
+static bool     _dancing;
+static uint8_t  _row;
+static uint8_t  _col;
+static uint8_t  _keycodes[5];  // see `KB_TAP_DANCE()`
+static uint8_t  _count;        // of presses (1..3)
+static bool     _is_pressed;
+static uint16_t _time;         // of the last press, or release
+
+// the keys that were decided while down, and are still down
+#define HOLDS_LENGTH  4
+
+static struct {
+	uint8_t key;      // row * KB_COLUMNS + col, + 1 (0 = unused)
+	uint8_t keycode;  // to release
+} _holds[HOLDS_LENGTH];
+
+// ----------------------------------------------------------------------------
+
+/*
+ * What the key does if tapped, or held, on the current count
+ */
+static uint8_t _tap(void) {
+	return _keycodes[KB_TAP_DANCE_TAP_1 + _count - 1];
+}
+
+static uint8_t _hold(void) {
+	switch (_count) {
+		case 1:  return _keycodes[KB_TAP_DANCE_HOLD];
+		case 2:  return _keycodes[KB_TAP_DANCE_TAP_HOLD];
+		default: return 0;
+	}
+}
+
+/*
+ * Could pressing the key again still mean something else?
+ */
+static bool _more(void) {
+	switch (_count) {
+		case 1:  return _keycodes[KB_TAP_DANCE_TAP_2]
+		                || _keycodes[KB_TAP_DANCE_TAP_3]
+		                || _keycodes[KB_TAP_DANCE_TAP_HOLD];
+		case 2:  return _keycodes[KB_TAP_DANCE_TAP_3];
+		default: return false;
+	}
+}
+
+/*
+ * Do what was decided: press the keycode if the key is still down (to be
+ * released with it), or tap it if not
+ */
+static void _emit(uint8_t keycode) {
+	_dancing = false;
+
+	if (_is_pressed) {
+		// (if too many are held already, this one does nothing)
+		for (uint8_t i=0; i<HOLDS_LENGTH; i++)
+			if (!_holds[i].key) {
+				_holds[i].key = _row * KB_COLUMNS + _col + 1;
+				_holds[i].keycode = keycode;
+				_kbfun_press_release(true, keycode);
+				break;
+			}
+	} else {
+		_kbfun_macro_tap(keyboard_modifier_keys, 0, keycode);
+	}
+}
+
+/*
+ * Decide now, with what's known so far
+ */
+static void _decide(void) {
+	_emit((_is_pressed && _hold()) ? _hold() : _tap());
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Count a press of the key being pressed (`main_arg_row`, `main_arg_col`)
+ *
+ * Arguments
+ * - keycodes: the key's entry (see `KB_TAP_DANCE()`); copied
+ */
+void _kbfun_tap_dance_press(const uint8_t * keycodes) {
+	if ( _dancing && _row == main_arg_row && _col == main_arg_col ) {
+		if (_count < 3)
+			_count++;
+	} else {
+		_dancing = true;
+		_row = main_arg_row;
+		_col = main_arg_col;
+		for (uint8_t i=0; i<5; i++)
+			_keycodes[i] = keycodes[i];
+		_count = 1;
+	}
+	_is_pressed = true;
+	_time = timer_ms();
+
+	if (!_hold() && !_more())
+		_emit(_tap());
+}
+
+/*
+ * Count a release of the key being released (`main_arg_row`,
+ * `main_arg_col`), or let go of what it was holding
+ */
+void _kbfun_tap_dance_release(void) {
+	uint8_t key = main_arg_row * KB_COLUMNS + main_arg_col + 1;
+
+	for (uint8_t i=0; i<HOLDS_LENGTH; i++)
+		if (_holds[i].key == key) {
+			_holds[i].key = 0;
+			_kbfun_press_release(false, _holds[i].keycode);
+			return;
+		}
+
+	if ( !_dancing || _row != main_arg_row || _col != main_arg_col )
+		return;
+
+	_is_pressed = false;
+	_time = timer_ms();
+
+	if (!_more())
+		_emit(_tap());
+}
+
+/*
+ * Decide, if the given key event is another key being pressed
+ *
+ * Returns
+ * - true: if a tap was decided, and the event is to wait until it's been
+ *   sent
+ * - false: if the event may go on
+ *
+ * Note
+ * - Called for every key event, before anything but the leader sees it.
+ */
+bool _kbfun_tap_dance_event(uint8_t row, uint8_t col, bool is_pressed) {
+	if ( !_dancing || !is_pressed || (row == _row && col == _col) )
+		return false;
+
+	bool tap = !_is_pressed;
+	_decide();
+	if (tap)
+		_kbfun_macro_fence();
+	return tap;
+}
+
+/*
+ * Decide, if the key has been down (or up) long enough
+ *
+ * Note
+ * - To be called once per scan.
+ */
+void _kbfun_tap_dance_tick(void) {
+	if (_dancing && timer_elapsed(_time) >= KB_TAPPING_TERM)
+		_decide();
+}
+
@@ -0,0 +1,245 @@
+/* ----------------------------------------------------------------------------
+ * key functions : tap-hold keys : code
+ *
+ * A tap-hold key sends one keycode when tapped, and does something else
+ * (holds a modifier, or a layer) when held.  Which it is can't be known when
+ * it's pressed, so from then until it's decided, the events of all other
+ * keys are held back in a buffer (with the time they happened), and replayed
+ * afterwards, in order.
+ *
+ * Decisions are made as soon as the buffered events allow (not when the
+ * tapping term runs out, unless that's the first thing that does):
+ * - released (before the tapping term is up): tap
+ * - down for the tapping term: hold
+ * - another key pressed (with `KB_TAP_HOLD_FLAG_ON_OTHER_KEY`): hold
+ * - another key pressed and released (with `KB_TAP_HOLD_FLAG_PERMISSIVE`):
+ *   hold
+ *
+ * So a key pressed while a tap-hold key is down waits at most the tapping
+ * term (less if the flags allow), and keys pressed at any other time don't
+ * wait at all.  After a tap, the buffered events wait (a scan at a time)
+ * until it has been sent (see `_kbfun_macro_fence()`), lest they go out in
+ * the same report.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../lib-other/pjrc/usb_keyboard/usb_keyboard.h"
+#include "../../lib/timer.h"
+#include "../../keyboard/layout.h"
+#include "../../keyboard/matrix.h"
+#include "../../main.h"
+#include "./private.h"
+
+// ----------------------------------------------------------------------------
+
+// must be a power of 2
+#define BUFFER_LENGTH  8
+
+static struct {
+	uint8_t  row;
+	uint8_t  col;
+	bool     is_pressed;
+	uint16_t time;
+} _buffer[BUFFER_LENGTH];
+
+static uint8_t _buffer_head;
+static uint8_t _buffer_count;
+
+// the key being decided
+static bool     _pending;
+static uint8_t  _row;
+static uint8_t  _col;
+static uint16_t _time;  // when it was pressed
+static uint8_t  _tap_keycode;
+static uint8_t  _hold;  // keycode, or layer
+static uint8_t  _flags;
+
+// the keys that were decided to be held, and are still down
+#define HOLDS_LENGTH  4
+
+static struct {
+	uint8_t key;       // row * KB_COLUMNS + col, + 1 (0 = unused)
+	uint8_t keycode;   // to release, or
+	uint8_t layer_id;  // to pop
+} _holds[HOLDS_LENGTH];
+
+// ----------------------------------------------------------------------------
+
+#define  at(i)  ( _buffer[ (_buffer_head + (i)) & (BUFFER_LENGTH-1) ] )
+
+/*
+ * Was the key in the given (buffered) release event pressed after the
+ * pending key was?
+ */
+static bool _pressed_since(uint8_t release) {
+	for (uint8_t i=0; i<release; i++)
+		if ( at(i).is_pressed
+		     && at(i).row == at(release).row
+		     && at(i).col == at(release).col )
+			return true;
+
+	return false;
+}
+
+/*
+ * Replay the buffered events (until one of them is another tap-hold key
+ * being pressed, or the macro player has taps to send first)
+ */
+static void _replay(void) {
+	while (_buffer_count && !_pending && _kbfun_macro_room()) {
+		uint8_t row = at(0).row;
+		uint8_t col = at(0).col;
+		bool is_pressed = at(0).is_pressed;
+
+		_buffer_head = (_buffer_head + 1) & (BUFFER_LENGTH-1);
+		_buffer_count--;
+		main_key_exec(row, col, is_pressed);
+	}
+}
+
+/*
+ * Do what was decided, then replay the buffered events
+ */
+static void _resolve(bool hold) {
+	_pending = false;
+
+	if (hold) {
+		// (if too many are held already, this one does nothing)
+		for (uint8_t i=0; i<HOLDS_LENGTH; i++)
+			if (!_holds[i].key) {
+				_holds[i].key = _row * KB_COLUMNS + _col + 1;
+				_holds[i].keycode = 0;
+				_holds[i].layer_id = 0;
+				if (_flags & KB_TAP_HOLD_FLAG_LAYER) {
+					_holds[i].layer_id =
+						main_layers_push(_hold, eStickyNone);
+				} else {
+					_holds[i].keycode = _hold;
+					_kbfun_press_release(true, _hold);
+				}
+				break;
+			}
+	} else {
+		// (as two reports, since the release is in the buffer too; the
+		// events buffered after it are replayed once both have been sent)
+		_kbfun_macro_tap(keyboard_modifier_keys, 0, _tap_keycode);
+		_kbfun_macro_fence();
+	}
+
+	_replay();
+}
+
+/*
+ * Decide, if the events so far (and the time) allow it
+ */
+static void _decide(void) {
+	while (_pending) {
+		uint8_t i;
+		for (i=0; i<_buffer_count; i++) {
+			if ((uint16_t)(at(i).time - _time) >= KB_TAPPING_TERM) {
+				_resolve(true);
+				break;
+			}
+			if (at(i).row == _row && at(i).col == _col) {
+				_resolve(false);
+				break;
+			}
+			if ( at(i).is_pressed
+			     ? (_flags & KB_TAP_HOLD_FLAG_ON_OTHER_KEY)
+			     : (_flags & KB_TAP_HOLD_FLAG_PERMISSIVE)
+			       && _pressed_since(i) ) {
+				_resolve(true);
+				break;
+			}
+		}
+		if (i < _buffer_count)
+			continue;  // (another key may be pending now)
+
+		if ( timer_elapsed(_time) >= KB_TAPPING_TERM
+		     || _buffer_count == BUFFER_LENGTH )
+			_resolve(true);
+		else
+			return;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Start deciding about the key being pressed (`main_arg_row`,
+ * `main_arg_col`)
+ *
+ * Arguments
+ * - tap_keycode: the keycode to tap, if it's tapped
+ * - hold: the keycode to hold, or the layer to push, if it's held
+ * - flags: see `KB_TAP_HOLD_FLAG_*`
+ */
+void _kbfun_tap_hold_press(uint8_t tap_keycode, uint8_t hold, uint8_t flags) {
+	_pending = true;
+	_row = main_arg_row;
+	_col = main_arg_col;
+	_time = timer_ms();
+	_tap_keycode = tap_keycode;
+	_hold = hold;
+	_flags = flags;
+}
+
+/*
+ * Let go of whatever the key being released (`main_arg_row`,
+ * `main_arg_col`) was holding (if anything)
+ */
+void _kbfun_tap_hold_release(void) {
+	uint8_t key = main_arg_row * KB_COLUMNS + main_arg_col + 1;
+
+	for (uint8_t i=0; i<HOLDS_LENGTH; i++)
+		if (_holds[i].key == key) {
+			_holds[i].key = 0;
+			if (_holds[i].layer_id)
+				main_layers_pop_id(_holds[i].layer_id);
+			_kbfun_press_release(false, _holds[i].keycode);
+		}
+}
+
+/*
+ * Hold back the given key event, if a key is being decided (or events
+ * buffered earlier are still waiting to be replayed)
+ *
+ * Returns
+ * - true: if the event was buffered (it'll be executed later)
+ * - false: if it should be executed now
+ */
+bool _kbfun_tap_hold_event(uint8_t row, uint8_t col, bool is_pressed) {
+	// (the events still buffered go first; with room for them now, at
+	// least one is replayed, so there's room for this one too)
+	_replay();
+	if (!_pending && !_buffer_count)
+		return false;
+
+	at(_buffer_count).row = row;
+	at(_buffer_count).col = col;
+	at(_buffer_count).is_pressed = is_pressed;
+	at(_buffer_count).time = timer_ms();
+	_buffer_count++;
+
+	_decide();
+	return true;
+}
+
+/*
+ * Replay the buffered events, once a tap has been sent; and decide, if the
+ * key being decided has been down long enough
+ *
+ * Note
+ * - To be called once per scan.
+ */
+void _kbfun_tap_hold_tick(void) {
+	_replay();
+	_decide();
+}
+
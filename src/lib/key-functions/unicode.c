@@ -0,0 +1,113 @@
+/* ----------------------------------------------------------------------------
+ * key functions : unicode characters : code
+ *
+ * Types a code point the way the host's input method expects it (see
+ * `UNICODE_MODE_*` in "private.h"):
+ * - Linux (IBus, GTK): ctrl+shift+u, the hex digits, then space
+ * - Windows (WinCompose, with right alt as the compose key): compose, u, the
+ *   hex digits, then enter
+ * - macOS ("Unicode Hex Input" source): the hex digits with alt held (code
+ *   points above U+FFFF as a UTF-16 surrogate pair)
+ *
+ * The keystrokes are queued with the macro player (see "macro.c"), and go
+ * out over the following reports; the scan goes on meanwhile.  Key events
+ * wait (in the matrix) while the queue hasn't room for another character,
+ * so typing faster than the host takes them never stalls the scan, and
+ * nothing typed after a character overtakes it.  None of them
+ * carry the user's own modifiers, so e.g. a held shift doesn't change the
+ * hex digits.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <avr/eeprom.h>
+#include "../../lib/usb/usage-page/keyboard.h"
+#include "../../keyboard/layout.h"
+#include "./private.h"
+
+// ----------------------------------------------------------------------------
+
+// modifier bits, as in the modifier byte of a USB report
+#define BIT_CONTROL  (1<<0)  // left control
+#define BIT_SHIFT    (1<<1)  // left shift
+#define BIT_ALT      (1<<2)  // left alt
+
+static uint8_t EEMEM _mode_eeprom;
+static uint8_t       _mode = 0xFF;  // (0xFF = not read from the EEPROM yet)
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Get the input method in use
+ */
+static uint8_t _get_mode(void) {
+	if (_mode == 0xFF) {
+		_mode = eeprom_read_byte(&_mode_eeprom);
+		if (_mode >= UNICODE_MODES)  // (erased EEPROM)
+			_mode = KB_UNICODE_MODE;
+	}
+	return _mode;
+}
+
+/*
+ * Tap the hex digits of the given number: at least `min_digits` of them
+ * (with leading zeros), and no more leading zeros than that
+ */
+static void _hex(uint8_t modifiers, uint32_t number, uint8_t min_digits) {
+	uint8_t digits = 8;
+
+	while (digits > min_digits && !(number >> (4 * (digits-1))))
+		digits--;
+
+	while (digits--) {
+		uint8_t digit = (number >> (4 * digits)) & 0xF;
+		_kbfun_macro_tap( modifiers, 0,
+		                  (digit == 0) ? KEY_0_RightParenthesis
+		                  : (digit < 10) ? KEY_1_Exclamation + digit - 1
+		                  : KEY_a_A + digit - 10 );
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Type the given code point
+ */
+void _kbfun_unicode_type(uint32_t code_point) {
+	switch (_get_mode()) {
+		case UNICODE_MODE_LINUX:
+			_kbfun_macro_tap(0, BIT_CONTROL|BIT_SHIFT, KEY_u_U);
+			_hex(0, code_point, 4);
+			_kbfun_macro_tap(0, 0, KEY_Spacebar);
+			return;
+		case UNICODE_MODE_WINCOMPOSE:
+			_kbfun_macro_tap(0, 0, KEY_RightAlt);
+			_kbfun_macro_tap(0, 0, KEY_u_U);
+			_hex(0, code_point, 4);
+			_kbfun_macro_tap(0, 0, KEY_ReturnEnter);
+			return;
+		case UNICODE_MODE_MACOS:
+			if (code_point > 0xFFFF) {
+				code_point -= 0x10000;
+				_hex(BIT_ALT, 0xD800 | (code_point >> 10), 4);
+				code_point = 0xDC00 | (code_point & 0x3FF);
+			}
+			_hex(BIT_ALT, code_point, 4);
+			_kbfun_macro_tap(0, 0, 0);  // (let go of alt)
+			return;
+	}
+}
+
+/*
+ * Switch to the next input method, and remember it
+ */
+void _kbfun_unicode_mode_next(void) {
+	_mode = (_get_mode() + 1) % UNICODE_MODES;
+	eeprom_update_byte(&_mode_eeprom, _mode);
+}
+
@@ -0,0 +1,137 @@
+/* ----------------------------------------------------------------------------
+ * Teensy 2.0 main loop profiler : code
+ *
+ * - Timer/Counter3 (16-bit, which nothing else here uses) counts freely at
+ *   clock / 8.  See the datasheet, section 14.
+ * - `profile_loop()` is called at the top of each iteration of the main
+ *   loop, and `profile_mark()` at the end of each stage: each stage's time
+ *   is the time since the last of these calls.
+ * - The minimum, maximum, and total time of each stage are kept (since the
+ *   last `profile_reset()`), along with the number of times it was timed,
+ *   and the number of iterations.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+// ----------------------------------------------------------------------------
+// conditional compile
+#if MAKEFILE_BOARD == teensy-2-0 && MAKEFILE_PROFILE
+// ----------------------------------------------------------------------------
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <avr/io.h>
+#include "./teensy-2-0.h"
+
+// ----------------------------------------------------------------------------
+
+static struct {
+	uint16_t min;
+	uint16_t max;
+	uint32_t total;
+	uint16_t count;
+} _stages[PROFILE_STAGES];
+
+static uint16_t _count;       // iterations counted
+static bool     _counting;    // (not until the next iteration starts, after
+                              //   a reset; nor after 65535 iterations)
+static uint16_t _last;        // when the last stage ended
+static uint16_t _loop_start;  // when this iteration started
+
+// ----------------------------------------------------------------------------
+
+static void _add(uint8_t stage, uint16_t ticks) {
+	if (ticks < _stages[stage].min)
+		_stages[stage].min = ticks;
+	if (ticks > _stages[stage].max)
+		_stages[stage].max = ticks;
+	_stages[stage].total += ticks;
+	_stages[stage].count++;
+}
+
+// ----------------------------------------------------------------------------
+
+void profile_init(void) {
+	TCCR3A = 0;          // normal mode (count up, and wrap)
+	TCCR3B = (1<<CS31);  // clock / 8 (2 MHz at 16 MHz)
+	profile_reset();
+}
+
+/*
+ * Start timing an iteration of the main loop (and finish timing the last)
+ */
+void profile_loop(void) {
+	uint16_t now = TCNT3;
+
+	if (_counting) {
+		_add(PROFILE_LOOP, now - _loop_start);
+		_count++;
+	}
+	_counting = (_count != 0xFFFF);  // (so the totals can't overflow)
+	_loop_start = _last = now;
+}
+
+/*
+ * Finish timing the given stage (started when the last one finished)
+ */
+void profile_mark(uint8_t stage) {
+	if (_counting)
+		_add(stage, TCNT3 - _last);
+	_last = TCNT3;  // (not counting this function)
+}
+
+/*
+ * Time the given stage from the start of this iteration (without finishing
+ * the stage in progress)
+ */
+void profile_since(uint8_t stage) {
+	if (_counting)
+		_add(stage, TCNT3 - _loop_start);
+}
+
+/*
+ * Don't count the rest of this iteration (e.g. when the main loop is about
+ * to wait, for longer than can be timed)
+ */
+void profile_skip(void) {
+	_counting = false;
+}
+
+void profile_get( uint8_t stage, uint16_t * min, uint16_t * max,
+                  uint32_t * total, uint16_t * count ) {
+	*min = _stages[stage].min;
+	*max = _stages[stage].max;
+	*total = _stages[stage].total;
+	*count = _stages[stage].count;
+}
+
+/*
+ * Get the number of iterations counted
+ */
+uint16_t profile_count(void) {
+	return _count;
+}
+
+/*
+ * Forget everything counted so far
+ */
+void profile_reset(void) {
+	for (uint8_t stage=0; stage<PROFILE_STAGES; stage++) {
+		_stages[stage].min = 0xFFFF;
+		_stages[stage].max = 0;
+		_stages[stage].total = 0;
+		_stages[stage].count = 0;
+	}
+	_count = 0;
+	_counting = false;
+}
+
+
+// ----------------------------------------------------------------------------
+#endif
+// ----------------------------------------------------------------------------
+
@@ -0,0 +1,65 @@
+/* ----------------------------------------------------------------------------
+ * Teensy 2.0 main loop profiler : exports
+ *
+ * Compiled in only if `MAKEFILE_PROFILE` is set (see "makefile-options");
+ * otherwise all of these are empty macros.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#ifndef PROFILE_h
+	#define PROFILE_h
+
+	#include <stdbool.h>
+	#include <stdint.h>
+
+	// --------------------------------------------------------------------
+
+	// the stages of the main loop, timed separately
+	#define PROFILE_MATRIX_TEENSY    0  // `teensy_update_matrix()`
+	#define PROFILE_MATRIX_MCP23018  1  // `mcp23018_update_matrix()`
+	#define PROFILE_DISPATCH         2  // key events, and ticks
+	#define PROFILE_USB_KEYBOARD     3  // the keyboard report
+	#define PROFILE_USB_EXTRA        4  // the consumer report
+	#define PROFILE_DEBOUNCE         5  // (and macro reports sent meanwhile)
+	#define PROFILE_LEDS             6
+	#define PROFILE_WAKE             7  // from leaving idle (e.g. for a
+	                                    //   press), to the next report
+	                                    //   (see "main.c")
+	#define PROFILE_LOOP             8  // all of it, start to start
+	#define PROFILE_STAGES           9
+
+	// times are counted in ticks of Timer/Counter3, at this many per
+	// microsecond; none may be longer than 65535 ticks (about 32 ms)
+	#define PROFILE_TICKS_PER_US  (F_CPU / 8 / 1000000)
+
+	// --------------------------------------------------------------------
+
+	#if MAKEFILE_PROFILE
+
+		void     profile_init  (void);
+		void     profile_loop  (void);
+		void     profile_mark  (uint8_t stage);
+		void     profile_since (uint8_t stage);
+		void     profile_skip  (void);
+		void     profile_get   (uint8_t stage, uint16_t * min,
+		                        uint16_t * max, uint32_t * total,
+		                        uint16_t * count);
+		uint16_t profile_count (void);
+		void     profile_reset (void);
+
+	#else
+
+		#define  profile_init()
+		#define  profile_loop()
+		#define  profile_mark(stage)
+		#define  profile_since(stage)
+		#define  profile_skip()
+
+	#endif
+
+#endif
+
@@ -0,0 +1,74 @@
+/* ----------------------------------------------------------------------------
+ * stack high-water mark : code
+ *
+ * Notes
+ * - Nothing here uses `malloc()`, so the heap (which would start at `_end`)
+ *   is empty, and all of the free SRAM is the stack's to grow into.
+ * - A byte the stack used may happen to have been left holding the known
+ *   byte; so the deepest the stack has been may be (a little) deeper than
+ *   reported.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdint.h>
+#include <avr/io.h>
+#include "./stack.h"
+
+// ----------------------------------------------------------------------------
+
+#define PAINT  0xC5
+
+// from the linker
+extern uint8_t _end;     // the first byte after the static variables
+extern uint8_t __stack;  // the top of the stack (`RAMEND`)
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Fill the free SRAM with `PAINT`
+ *
+ * Notes
+ * - In ".init1", this runs right after reset, before the C runtime has set
+ *   up even `__zero_reg__`: so it can't be C, or be called.
+ * - Nothing is on the stack yet, so all of it can be painted.
+ */
+void stack_paint(void) __attribute__ ((naked, used, section(".init1")));
+void stack_paint(void) {
+	__asm__ __volatile__ (
+		"	ldi r30, lo8(_end)           \n"
+		"	ldi r31, hi8(_end)           \n"
+		"	ldi r24, %[paint]            \n"
+		"	ldi r25, hi8(__stack)        \n"
+		"1:	st  Z+, r24                  \n"
+		"	cpi r30, lo8(__stack)        \n"
+		"	cpc r31, r25                 \n"
+		"	brlo 1b                      \n"
+		"	breq 1b                      \n"
+		:: [paint] "M" (PAINT) );
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Get the number of bytes of SRAM the stack has never reached
+ */
+uint16_t stack_unused(void) {
+	const uint8_t * p = &_end;
+
+	while (p <= &__stack && *p == PAINT)
+		p++;
+
+	return p - &_end;
+}
+
+/*
+ * Get the most bytes of SRAM the stack has used (at any time since reset)
+ */
+uint16_t stack_used(void) {
+	return (&__stack - &_end + 1) - stack_unused();
+}
+
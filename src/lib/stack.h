@@ -0,0 +1,26 @@
+/* ----------------------------------------------------------------------------
+ * stack high-water mark : exports
+ *
+ * At reset (before anything else runs), the free SRAM between the end of the
+ * static variables and the top of the stack is filled with a known byte.
+ * The stack grows down into it; so however much of that is still the known
+ * byte, the stack has never reached.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#ifndef LIB__STACK_h
+	#define LIB__STACK_h
+
+	#include <stdint.h>
+
+	// --------------------------------------------------------------------
+
+	uint16_t stack_unused (void);
+	uint16_t stack_used   (void);
+
+#endif
+
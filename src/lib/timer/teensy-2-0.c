@@ -0,0 +1,56 @@
+/* ----------------------------------------------------------------------------
+ * Very simple Teensy 2.0 millisecond timer : code
+ *
+ * - Timer/Counter0 (the 8-bit one, which nothing else here uses) in CTC mode,
+ *   interrupting once every millisecond.  See the datasheet, section 13.
+ * - The count wraps about every 65 seconds; compare times by subtracting
+ *   them (see `timer_elapsed()`), never directly.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+// ----------------------------------------------------------------------------
+// conditional compile
+#if MAKEFILE_BOARD == teensy-2-0
+// ----------------------------------------------------------------------------
+
+
+#include <stdint.h>
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include "./teensy-2-0.h"
+
+// ----------------------------------------------------------------------------
+
+static volatile uint16_t _ms;
+
+// ----------------------------------------------------------------------------
+
+void timer_init(void) {
+	TCCR0A = (1<<WGM01);            // CTC mode (count up to OCR0A)
+	TCCR0B = (1<<CS01)|(1<<CS00);   // clock / 64 (250 kHz at 16 MHz)
+	OCR0A  = (F_CPU / 64 / 1000) - 1;  // so: interrupt at 1 kHz
+	TIMSK0 = (1<<OCIE0A);
+	sei();
+}
+
+uint16_t timer_ms(void) {
+	uint8_t sreg = SREG;
+	cli();
+	uint16_t ms = _ms;
+	SREG = sreg;
+	return ms;
+}
+
+ISR(TIMER0_COMPA_vect) {
+	_ms++;
+}
+
+
+// ----------------------------------------------------------------------------
+#endif
+// ----------------------------------------------------------------------------
+
@@ -0,0 +1,26 @@
+/* ----------------------------------------------------------------------------
+ * Very simple Teensy 2.0 millisecond timer : exports
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#ifndef TIMER_h
+	#define TIMER_h
+
+	#include <stdint.h>
+
+	// --------------------------------------------------------------------
+
+	void     timer_init (void);
+	uint16_t timer_ms   (void);
+
+	// milliseconds since `then` (a previous value of `timer_ms()`), correct
+	// across the counter wrapping, as long as less than 65 seconds have
+	// passed
+	#define timer_elapsed(then) ( (uint16_t) (timer_ms() - (then)) )
+
+#endif
+
@@ -27,29 +27,124 @@
 // ----------------------------------------------------------------------------
 
 
+#include <stdbool.h>
+#include <stdint.h>
+#include <avr/io.h>
+#include <util/delay.h>
 #include <util/twi.h>
 #include "./teensy-2-0.h"
 
 // ----------------------------------------------------------------------------
 
+struct twi_errors twi_errors;
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Free a bus that a device is holding: disable the TWI, clock SCL (PD0) up
+ * to 9 times (until the device lets go of SDA, PD1), send a stop, and start
+ * over
+ *
+ * Note
+ * - A device that lost power, or saw a glitch on SCL, in the middle of a
+ *   byte may still be driving SDA low, waiting for the rest of its clocks.
+ */
+static void _clear_bus(void) {
+	TWCR = 0;
+
+	// open drain: both released (inputs, held high by the external
+	// pull-ups), with their outputs set low, so that making either an
+	// output drives it low (the internal pull-ups are turned back on by
+	// `twi_init()`)
+	DDRD  &= ~( (1<<PD1)|(1<<PD0) );
+	PORTD &= ~( (1<<PD1)|(1<<PD0) );
+
+	for (uint8_t i=0; i<9 && !(PIND & (1<<PD1)); i++) {
+		DDRD |= (1<<PD0);  _delay_us(5);
+		DDRD &= ~(1<<PD0); _delay_us(5);
+	}
+
+	// stop: SDA low, then rising while SCL is high (released)
+	DDRD |= (1<<PD1);  _delay_us(5);
+	DDRD &= ~(1<<PD1); _delay_us(5);
+
+	twi_init();
+}
+
+/*
+ * Wait (a bounded time) for the hardware to finish the current operation
+ *
+ * Returns
+ * - success: 0
+ * - failure: `TWI_ERROR_TIMEOUT`, or `TWI_ERROR_BUS` (and the bus has been
+ *   cleared)
+ */
+static uint8_t _wait(void) {
+	for (uint16_t us=0; !(TWCR & (1<<TWINT)); us++) {
+		if (us == TWI_TIMEOUT) {
+			twi_errors.timeout++;
+			_clear_bus();
+			return TWI_ERROR_TIMEOUT;
+		}
+		_delay_us(1);
+	}
+
+	if (TW_STATUS == TW_BUS_ERROR) {
+		twi_errors.bus++;
+		_clear_bus();
+		return TWI_ERROR_BUS;
+	}
+
+	return 0;
+}
+
+/*
+ * Count the given (unexpected) status code, and pass it on
+ */
+static uint8_t _error(uint8_t status) {
+	switch (status) {
+		case TW_MT_ARB_LOST:  // (== TW_MR_ARB_LOST)
+			twi_errors.arbitration++;
+			break;
+		case TW_MT_SLA_NACK:
+		case TW_MT_DATA_NACK:
+		case TW_MR_SLA_NACK:
+		case TW_MR_DATA_NACK:
+			twi_errors.nack++;
+			break;
+	}
+	return status;
+}
+
+// ----------------------------------------------------------------------------
+
 void twi_init(void) {
+	// SDA (PD1) and SCL (PD0) released, with the internal pull-ups on
+	DDRD  &= ~( (1<<PD1)|(1<<PD0) );
+	PORTD |=  ( (1<<PD1)|(1<<PD0) );
 	// set the prescaler value to 0
 	TWSR &= ~( (1<<TWPS1)|(1<<TWPS0) );
 	// set the bit rate
 	// - TWBR should be 10 or higher (datasheet section 20.5.2)
 	// - TWI_FREQ should be 400000 (400kHz) max (datasheet section 20.1)
 	TWBR = ((F_CPU / TWI_FREQ) - 16) / 2;
+	// enable (this happens anyway, with the first operation; but not
+	// before the bus is cleared, if it needs to be)
+	TWCR = (1<<TWEN);
 }
 
 uint8_t twi_start(void) {
+	uint8_t ret;
+
 	// send start
 	TWCR = (1<<TWINT)|(1<<TWEN)|(1<<TWSTA);
 	// wait for transmission to complete
-	while (!(TWCR & (1<<TWINT)));
+	if ((ret = _wait()))
+		return ret;  // error
 	// if it didn't work, return the status code (else return 0)
 	if ( (TW_STATUS != TW_START) &&
 	     (TW_STATUS != TW_REP_START) )
-		return TW_STATUS;  // error
+		return _error(TW_STATUS);  // error
 	return 0;  // success
 }
 
@@ -57,34 +152,47 @@ void twi_stop(void) {
 	// send stop
 	TWCR = (1<<TWINT)|(1<<TWEN)|(1<<TWSTO);
 	// wait for transmission to complete
-	while (TWCR & (1<<TWSTO));
+	for (uint16_t us=0; TWCR & (1<<TWSTO); us++) {
+		if (us == TWI_TIMEOUT) {
+			twi_errors.timeout++;
+			_clear_bus();
+			return;
+		}
+		_delay_us(1);
+	}
 }
 
 uint8_t twi_send(uint8_t data) {
+	uint8_t ret;
+
 	// load data into the data register
 	TWDR = data;
 	// send data
 	TWCR = (1<<TWINT)|(1<<TWEN);
 	// wait for transmission to complete
-	while (!(TWCR & (1<<TWINT)));
+	if ((ret = _wait()))
+		return ret;  // error
 	// if it didn't work, return the status code (else return 0)
 	if ( (TW_STATUS != TW_MT_SLA_ACK)  &&
 	     (TW_STATUS != TW_MT_DATA_ACK) &&
 	     (TW_STATUS != TW_MR_SLA_ACK) )
-		return TW_STATUS;  // error
+		return _error(TW_STATUS);  // error
 	return 0;  // success
 }
 
 uint8_t twi_read(uint8_t * data) {
+	uint8_t ret;
+
 	// read 1 byte to TWDR, send ACK
 	TWCR = (1<<TWINT)|(1<<TWEN)|(1<<TWEA);
 	// wait for transmission to complete
-	while (!(TWCR & (1<<TWINT)));
+	if ((ret = _wait()))
+		return ret;  // error
 	// set data variable
 	*data = TWDR;
 	// if it didn't work, return the status code (else return 0)
 	if (TW_STATUS != TW_MR_DATA_ACK)
-		return TW_STATUS;  // error
+		return _error(TW_STATUS);  // error
 	return 0;  // success
 }
 
@@ -12,12 +12,34 @@
 
 	// --------------------------------------------------------------------
 
+	#include <stdint.h>
+
+	// --------------------------------------------------------------------
+
 	#ifndef TWI_FREQ
 		#define TWI_FREQ 100000  // in Hz
 	#endif
 
+	// how long to wait for the hardware, before giving up on the bus (a
+	// byte takes about 90 us at 100 kHz)
+	#ifndef TWI_TIMEOUT
+		#define TWI_TIMEOUT 1000  // in us (approximately)
+	#endif
+
+	// returned instead of a status code (which are all multiples of 8)
+	#define TWI_ERROR_TIMEOUT  0x01  // (the bus has been cleared)
+	#define TWI_ERROR_BUS      0x02  // illegal start or stop (ditto)
+
 	// --------------------------------------------------------------------
 
+	// errors since startup, by kind (each wraps at 65535)
+	extern struct twi_errors {
+		uint16_t timeout;
+		uint16_t bus;
+		uint16_t arbitration;
+		uint16_t nack;  // (e.g. nothing at the address: unplugged)
+	} twi_errors;
+
 	void    twi_init  (void);
 	uint8_t twi_start (void);
 	void    twi_stop  (void);
@@ -10,9 +10,20 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <avr/eeprom.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+#include <string.h>
 #include <util/delay.h>
 #include "./lib-other/pjrc/usb_keyboard/usb_keyboard.h"
+#include "./lib/chatter.h"
+#include "./lib/fault.h"
+#include "./lib/debug.h"
+#include "./lib/heatmap.h"
+#include "./lib/profile.h"
+#include "./lib/timer.h"
 #include "./lib/key-functions/public.h"
+#include "./lib/key-functions/hooks.h"
 #include "./keyboard/controller.h"
 #include "./keyboard/layout.h"
 #include "./keyboard/matrix.h"
@@ -20,7 +31,38 @@
 
 // ----------------------------------------------------------------------------
 
-#define  MAX_ACTIVE_LAYERS  20
+// - may be overridden by the layout specific '.h'
+// - independent of the number of layers defined (`KB_LAYERS`); this bounds
+//   the SRAM used by the layer stack, not which layers may be pushed
+#ifndef MAX_ACTIVE_LAYERS
+	#define  MAX_ACTIVE_LAYERS  20
+#endif
+#if MAX_ACTIVE_LAYERS > 32
+	#error "MAX_ACTIVE_LAYERS must be 32 or less (see `layers_ids_in_use`)"
+#endif
+
+// - may be overridden by the layout specific '.h'
+// - scans in a row with no key pressed (and no macro playing) before idling
+//   (see `main()`); 0 for never
+#ifndef MAIN_IDLE_SCANS
+	#define  MAIN_IDLE_SCANS  200  // (about a second, at 5 ms per scan)
+#endif
+
+// - may be overridden by the layout specific '.h'
+// - key events (presses and releases) kept while starting up (see `main()`);
+//   must be a power of 2, and no more than 128
+#ifndef MAIN_BOOT_EVENTS
+	#define  MAIN_BOOT_EVENTS  32
+#endif
+
+// how long after the host has configured the keyboard to start passing on
+// key events (giving the OS time to load drivers, etc.)
+#define  MAIN_BOOT_SETTLE  1000  // in milliseconds
+
+// startup states (see `main()`)
+#define  BOOT_USB     0  // waiting for the host to configure the keyboard
+#define  BOOT_SETTLE  1  // waiting `MAIN_BOOT_SETTLE`
+#define  BOOT_READY   2
 
 // ----------------------------------------------------------------------------
 
@@ -30,9 +72,11 @@ bool (*main_kb_is_pressed)[KB_ROWS][KB_COLUMNS] = &_main_kb_is_pressed;
 static bool _main_kb_was_pressed[KB_ROWS][KB_COLUMNS];
 bool (*main_kb_was_pressed)[KB_ROWS][KB_COLUMNS] = &_main_kb_was_pressed;
 
-static bool main_kb_was_transparent[KB_ROWS][KB_COLUMNS];
-
-uint8_t main_layers_pressed[KB_ROWS][KB_COLUMNS];
+// see "main.h"; accessed through `main_layers_pressed_*()` and
+// `main_kb_was_transparent_*()`
+uint8_t main_layers_pressed[ ( KB_ROWS*KB_COLUMNS
+                               + MAIN_KEYS_PER_PRESSED_BYTE-1 )
+                             / MAIN_KEYS_PER_PRESSED_BYTE ];
 
 uint8_t main_loop_row;
 uint8_t main_loop_col;
@@ -46,91 +90,260 @@ bool    main_arg_was_pressed;
 bool    main_arg_any_non_trans_key_pressed;
 bool    main_arg_trans_key_pressed;
 
+bool    main_layers_changed = true;  // so the LEDs are set at startup
+
+uint16_t main_boot_usb_ms;
+uint16_t main_boot_first_key_ms;
+
+// key events kept while starting up (`row * KB_COLUMNS + col`, with the high
+// bit set for a press)
+static uint8_t _main_boot_events[MAIN_BOOT_EVENTS];
+static uint8_t _main_boot_events_head;
+static uint8_t _main_boot_events_count;
+
+uint8_t main_keymap;
+
+#if KB_KEYMAPS > 1
+	const uint8_t * main_keymap_layers = _kb_keymap_layers[0];
+	uint8_t         main_keymap_layer_count;
+
+	static uint8_t EEMEM main_keymap_eeprom;
+#endif
+
 // ----------------------------------------------------------------------------
 
+/*
+ * Let keys waiting on a timeout (combos, tap-hold keys, tap-dance keys,
+ * leader sequences, one-shot modifiers and sticky layers) decide; and save
+ * the press counts, if it's time (a byte at a time)
+ */
+static void _main_tick(void) {
+	_kbfun_combo_tick();
+	_kbfun_tap_hold_tick();
+	_kbfun_tap_dance_tick();
+	_kbfun_leader_tick();
+	_kbfun_one_shot_tick();
+	_kbfun_macro_record_tick();
+	heatmap_tick();
+}
+
+/*
+ * Keep a key event, to pass on once started up
+ *
+ * Returns
+ * - whether there was room (if not, the key is to be left as it was, so
+ *   the event is seen again on the next scan)
+ */
+static bool _main_boot_keep(uint8_t row, uint8_t col, bool is_pressed) {
+	if (_main_boot_events_count == MAIN_BOOT_EVENTS)
+		return false;
+
+	_main_boot_events[ ( _main_boot_events_head + _main_boot_events_count++ )
+	                   & (MAIN_BOOT_EVENTS-1) ] =
+		(row * KB_COLUMNS + col) | (is_pressed ? 0x80 : 0);
+
+	return true;
+}
+
+/*
+ * Pass on the oldest key event kept (only one per scan, so that each gets
+ * its own report)
+ *
+ * Returns
+ * - whether it was a press
+ */
+static bool _main_boot_replay(void) {
+	uint8_t event = _main_boot_events[_main_boot_events_head];
+	uint8_t key = event & 0x7F;
+	bool is_pressed = event & 0x80;
+
+	// (if it has to wait, it's passed on again on the next scan)
+	if (!main_key_event(key / KB_COLUMNS, key % KB_COLUMNS, is_pressed))
+		return false;
+
+	_main_boot_events_head = (_main_boot_events_head + 1)
+	                         & (MAIN_BOOT_EVENTS-1);
+	_main_boot_events_count--;
+
+	if (is_pressed)
+		heatmap_press(key / KB_COLUMNS, key % KB_COLUMNS);
+
+	return is_pressed;
+}
+
 /*
  * main()
  */
 int main(void) {
 	kb_init();  // does controller initialization too
 
+	#if KB_KEYMAPS > 1
+		main_keymap_select(eeprom_read_byte(&main_keymap_eeprom));
+	#endif
+
 	kb_led_state_power_on();
 
-	usb_init();
-	while (!usb_configured());
-	kb_led_delay_usb_init();  // give the OS time to load drivers, etc.
+	timer_init();
+	heatmap_init();  // (if `MAKEFILE_HEATMAP`; see "lib/heatmap.h")
+	profile_init();  // (if `MAKEFILE_PROFILE`; see "lib/profile.h")
+	usb_init();  // (the host configures the keyboard later; see below)
 
-	kb_led_state_ready();
+	uint8_t  boot = BOOT_USB;  // startup state
+	uint8_t  boot_step = 0;    // of the LEDs (see `kb_led_usb_init_step()`)
+	uint16_t boot_time = 0;    // when the host configured the keyboard
+
+	uint8_t  leds_was = 0xFF;  // not a valid report: set the LEDs at startup
+	uint16_t quiet_scans = 0;  // in a row (see `MAIN_IDLE_SCANS`)
+	bool     woke = false;     // (from idle, on this scan)
 
 	for (;;) {
+		profile_loop();
+
+		// start up, without waiting: scan from the first, but keep the key
+		// events until the host has configured the keyboard, and had
+		// `MAIN_BOOT_SETTLE` to load drivers and so on; then pass them on
+		// (see `_main_boot_replay()`)
+		if (boot == BOOT_USB && usb_configured()) {
+			boot = BOOT_SETTLE;
+			boot_time = main_boot_usb_ms = timer_ms();
+		}
+		if (boot == BOOT_SETTLE) {
+			uint16_t elapsed = timer_elapsed(boot_time);
+			if ( boot_step < 3
+			     && elapsed >= boot_step * (MAIN_BOOT_SETTLE/3) )
+				kb_led_usb_init_step(boot_step++);
+			if (elapsed >= MAIN_BOOT_SETTLE) {
+				boot = BOOT_READY;
+				kb_led_state_ready();
+			}
+		}
+		bool booting = (boot != BOOT_READY || _main_boot_events_count);
+		bool first_key = false;  // (pressed on this scan)
+
 		// swap `main_kb_is_pressed` and `main_kb_was_pressed`, then update
+		// (holding back the keys that chatter, and those that look like
+		// electrical faults; see "lib/chatter.h" and "lib/fault.h")
 		bool (*temp)[KB_ROWS][KB_COLUMNS] = main_kb_was_pressed;
 		main_kb_was_pressed = main_kb_is_pressed;
 		main_kb_is_pressed = temp;
 
 		kb_update_matrix(*main_kb_is_pressed);
+		chatter_update(*main_kb_was_pressed, *main_kb_is_pressed);
+		fault_update(*main_kb_was_pressed, *main_kb_is_pressed);
 
 		// this loop is responsible to
-		// - "execute" keys when they change state
-		// - keep track of which layers the keys were on when they were pressed
-		//   (so they can be released using the function from that layer)
+		// - pass on the keys that changed state (see `main_key_event()`)
 		//
 		// note
 		// - everything else is the key function's responsibility
 		//   - see the keyboard layout file ("keyboard/ergodox/layout/*.c") for
 		//     which key is assigned which function (per layer)
 		//   - see "lib/key-functions/public/*.c" for the function definitions
+		bool any_pressed = false;
 		#define row          main_loop_row
 		#define col          main_loop_col
-		#define layer        main_arg_layer
-		#define is_pressed   main_arg_is_pressed
-		#define was_pressed  main_arg_was_pressed
 		for (row=0; row<KB_ROWS; row++) {
 			for (col=0; col<KB_COLUMNS; col++) {
-				is_pressed = (*main_kb_is_pressed)[row][col];
-				was_pressed = (*main_kb_was_pressed)[row][col];
-
-				if (is_pressed != was_pressed) {
-					if (is_pressed) {
-						layer = main_layers_peek(0);
-						main_layers_pressed[row][col] = layer;
-						main_arg_trans_key_pressed = false;
-					} else {
-						layer = main_layers_pressed[row][col];
-						main_arg_trans_key_pressed = main_kb_was_transparent[row][col];
+				bool is_pressed = (*main_kb_is_pressed)[row][col];
+				any_pressed |= is_pressed;
+
+				if (is_pressed != (*main_kb_was_pressed)[row][col]) {
+					if (booting) {
+						if (!_main_boot_keep(row, col, is_pressed))
+							(*main_kb_is_pressed)[row][col] = !is_pressed;
+					} else if (!main_key_event(row, col, is_pressed)) {
+						(*main_kb_is_pressed)[row][col] = !is_pressed;
+					} else if (is_pressed) {
+						heatmap_press(row, col);
+						first_key |= !main_boot_first_key_ms;
 					}
-
-					// set remaining vars, and "execute" key
-					main_arg_row          = row;
-					main_arg_col          = col;
-					main_arg_layer_offset = 0;
-					main_exec_key();
-					main_kb_was_transparent[row][col] = main_arg_trans_key_pressed;
 				}
 			}
 		}
 		#undef row
 		#undef col
-		#undef layer
-		#undef is_pressed
-		#undef was_pressed
 
-		// send the USB report (even if nothing's changed)
-		usb_keyboard_send();
+		if (boot == BOOT_READY && _main_boot_events_count)
+			first_key |= _main_boot_replay() && !main_boot_first_key_ms;
+
+		// let keys waiting on a timeout decide (and so on)
+		_main_tick();
+		profile_mark(PROFILE_DISPATCH);
+
+		// send the USB report (even if nothing's changed), or the next
+		// step of a macro, if one is playing
+		_kbfun_macro_send();
+		profile_mark(PROFILE_USB_KEYBOARD);
+		if (woke) {
+			woke = false;
+			profile_since(PROFILE_WAKE);
+		}
+		if (first_key) {
+			main_boot_first_key_ms = timer_ms();
+			dprintf( "boot: usb %u ms, first key %u ms\n",
+			         main_boot_usb_ms, main_boot_first_key_ms );
+		}
 		usb_extra_consumer_send();
-		_delay_ms(MAKEFILE_DEBOUNCE_TIME);
-
-		// update LEDs
-		if (keyboard_leds & (1<<0)) { kb_led_num_on(); }
-		else { kb_led_num_off(); }
-		if (keyboard_leds & (1<<1)) { kb_led_caps_on(); }
-		else { kb_led_caps_off(); }
-		if (keyboard_leds & (1<<2)) { kb_led_scroll_on(); }
-		else { kb_led_scroll_off(); }
-		if (keyboard_leds & (1<<3)) { kb_led_compose_on(); }
-		else { kb_led_compose_off(); }
-		if (keyboard_leds & (1<<4)) { kb_led_kana_on(); }
-		else { kb_led_kana_off(); }
+		profile_mark(PROFILE_USB_EXTRA);
+
+		// debounce; meanwhile, keep a playing macro (and the debug console,
+		// if `MAKEFILE_DEBUG`; see "lib/debug.h") going as fast as the host
+		// will take them
+		for (uint8_t ms=0; ms<MAKEFILE_DEBOUNCE_TIME; ms++) {
+			_delay_ms(1);
+			if (_kbfun_macro_busy() && usb_keyboard_ready())
+				_kbfun_macro_send();
+			debug_flush();
+		}
+		profile_mark(PROFILE_DEBOUNCE);
+
+		// update LEDs (only if something they show has changed; and not
+		// while they're showing how far along startup is)
+		uint8_t leds = keyboard_leds;  // (set by the USB interrupt)
+		if (boot == BOOT_READY && leds != leds_was) {
+			leds_was = leds;
+			kb_led_host_changed(leds);
+		}
+		if (boot == BOOT_READY && main_layers_changed) {
+			main_layers_changed = false;
+			kb_led_layer_changed(main_layers_peek(0));
+		}
+		profile_mark(PROFILE_LEDS);
+
+		// idle, after enough quiet scans: sleep until the next interrupt
+		// (the millisecond timer's, if not another's first), check quickly
+		// for a press, let keys waiting on a timeout decide, and so on,
+		// until there's something to do
+		// - the rows are on port F, which can't interrupt on a change, so
+		//   they're polled; but a press is still seen within about 1 ms,
+		//   and scanned right away (see `PROFILE_WAKE` for the rest)
+		// - no reports are sent meanwhile (the USB interrupt still sends
+		//   the last one again, if the host has asked for that); so if a
+		//   timeout changes what's in it (e.g. one-shot modifiers running
+		//   out), that ends the idle too, and the new report is sent on the
+		//   next scan
+		if (any_pressed || _kbfun_macro_busy() || booting) {
+			quiet_scans = 0;
+		} else if (MAIN_IDLE_SCANS && ++quiet_scans >= MAIN_IDLE_SCANS) {
+			quiet_scans = 0;
+			profile_skip();  // (the wait can't be timed)
+
+			uint8_t modifiers = keyboard_modifier_keys;
+			uint8_t keys[sizeof(keyboard_keys)];
+			memcpy(keys, keyboard_keys, sizeof(keys));
+
+			set_sleep_mode(SLEEP_MODE_IDLE);
+			while ( !kb_any_key_pressed() && !_kbfun_macro_busy()
+			        && keyboard_leds == leds_was && !main_layers_changed
+			        && keyboard_modifier_keys == modifiers
+			        && !memcmp(keyboard_keys, keys, sizeof(keys)) ) {
+				sleep_mode();
+				_main_tick();
+				debug_flush();
+			}
+
+			woke = true;
+		}
 	}
 
 	return 0;
@@ -140,10 +353,6 @@ int main(void) {
 
 // convenience macros (for the helper functions below)
 #define  layer        main_arg_layer
-#define  row          main_arg_row
-#define  col          main_arg_col
-#define  is_pressed   main_arg_is_pressed
-#define  was_pressed  main_arg_was_pressed
 
 // ----------------------------------------------------------------------------
 
@@ -163,13 +372,98 @@ struct layers {
 	uint8_t layer;
 	uint8_t id;
 	uint8_t sticky;
+	#if KB_KEYMAPS > 1
+		uint8_t layout_layer;  // `layer`, translated by the active keymap
+	#endif
 };
 
 // ----------------------------------------------------------------------------
 
 struct layers layers[MAX_ACTIVE_LAYERS];
 uint8_t       layers_head = 0;
-uint8_t       layers_ids_in_use[MAX_ACTIVE_LAYERS] = {true};
+uint32_t      layers_ids_in_use = 1;  // bit `n` set if id `n` is in use (id 0
+				      //   is the base layer, always in use)
+
+#define  layers_id_bit(id)  ((uint32_t)1 << (id))
+
+// the layer to look keys up in, for the given element
+#if KB_KEYMAPS > 1
+	#define  layers_layout_layer(element)  (layers[element].layout_layer)
+#else
+	#define  layers_layout_layer(element)  (layers[element].layer)
+#endif
+
+/*
+ * Key event
+ * - Something happened to the key at the given position.
+ * - Events wait (returning false, so the caller leaves the key as it was,
+ *   and passes the event on again on the next scan) while the macro player
+ *   is short of room, or has taps to send first (see
+ *   "lib/key-functions/macro.c"); or when a tap-dance key decides on a tap
+ *   because of this one (see "lib/key-functions/tap-dance.c").
+ * - Events typed into a leader sequence are taken first (see
+ *   "lib/key-functions/leader.c").
+ * - Events may be held back by the key functions for a while, and are
+ *   executed (in order) later, by `main_key_exec()`.  In order:
+ *   - until it's known whether they're part of a combo (see
+ *     "lib/key-functions/combo.c")
+ *   - until a tap-hold key decides what it is (see
+ *     "lib/key-functions/tap-hold.c")
+ */
+bool main_key_event(uint8_t row, uint8_t col, bool is_pressed) {
+	if (!_kbfun_macro_room())
+		return false;
+	if (_kbfun_leader_event(row, col, is_pressed))
+		return true;
+	if (_kbfun_tap_dance_event(row, col, is_pressed))
+		return false;
+	if (_kbfun_combo_event(row, col, is_pressed))
+		return true;
+	if (_kbfun_tap_hold_event(row, col, is_pressed))
+		return true;
+
+	main_key_exec(row, col, is_pressed);
+	return true;
+}
+
+/*
+ * Key exec
+ * - Look up the function of the key at the given position (on the layer it
+ *   was pressed on, if it's being released), and execute it.
+ * - Keeps track of which layers the keys were on when they were pressed (so
+ *   they can be released using the function from that layer).
+ */
+void main_key_exec(uint8_t row, uint8_t col, bool is_pressed) {
+	if (is_pressed) {
+		uint8_t flags = kb_layout_key_flags_get(row, col);
+		layer = main_layers_peek_layout(0);
+		main_arg_trans_key_pressed = false;
+		// skip the stack (and the walk down it) when the layout
+		// compiler has told us where we'd end up
+		if (flags & KB_LAYOUT_KEY_FLAG_STATIC) {
+			layer = 0;
+		} else if (flags & KB_LAYOUT_KEY_FLAG_TRANSPARENT_ABOVE_0) {
+			uint8_t base = kb_keymap_layer_get(0);
+			if (layer != base) {
+				layer = base;
+				main_arg_trans_key_pressed = true;
+			}
+		}
+		main_layers_pressed_set(row, col, layer);
+	} else {
+		layer = main_layers_pressed_get(row, col);
+		main_arg_trans_key_pressed = main_kb_was_transparent_get(row, col);
+	}
+
+	// set remaining vars, and "execute" key
+	main_arg_row          = row;
+	main_arg_col          = col;
+	main_arg_is_pressed   = is_pressed;
+	main_arg_was_pressed  = !is_pressed;
+	main_arg_layer_offset = 0;
+	main_exec_key();
+	main_kb_was_transparent_set(row, col, main_arg_trans_key_pressed);
+}
 
 /*
  * Exec key
@@ -178,9 +472,9 @@ uint8_t       layers_ids_in_use[MAX_ACTIVE_LAYERS] = {true};
  */
 void main_exec_key(void) {
 	void (*key_function)(void) =
-		( (is_pressed)
-		  ? kb_layout_press_get(layer, row, col)
-		  : kb_layout_release_get(layer, row, col) );
+		( (main_arg_is_pressed)
+		  ? kb_layout_press_get(layer, main_arg_row, main_arg_col)
+		  : kb_layout_release_get(layer, main_arg_row, main_arg_col) );
 
 	if (key_function)
 		(*key_function)();
@@ -188,7 +482,7 @@ void main_exec_key(void) {
 	// If the current layer is in the sticky once up state and a key defined
 	//  for this layer (a non-transparent key) was pressed, pop the layer
 	if (layers[layers_head].sticky == eStickyOnceUp && main_arg_any_non_trans_key_pressed)
-		main_layers_pop_id(layers_head);
+		main_layers_pop_id(layers[layers_head].id);
 }
 
 /*
@@ -208,6 +502,25 @@ uint8_t main_layers_peek(uint8_t offset) {
 	return 0;  // default, or error
 }
 
+/*
+ * peek_layout()
+ *
+ * Arguments
+ * - 'offset': the offset (down the stack) from the head element
+ *
+ * Returns
+ * - success: the layer of the layout matrices that keys should be looked up
+ *   in, for the requested element (the same as its layer-number, unless
+ *   several keymaps are linked in)
+ * - failure: the base layer (default) (out of bounds)
+ */
+uint8_t main_layers_peek_layout(uint8_t offset) {
+	if (offset <= layers_head)
+		return layers_layout_layer(layers_head - offset);
+
+	return layers_layout_layer(0);  // default, or error
+}
+
 uint8_t main_layers_peek_sticky(uint8_t offset) {
 	if (offset <= layers_head)
 		return layers[layers_head - offset].sticky;
@@ -215,6 +528,20 @@ uint8_t main_layers_peek_sticky(uint8_t offset) {
 	return 0;  // default, or error
 }
 
+/*
+ * peek_id()
+ *
+ * Returns
+ * - success: the id of the requested element (to pop it by)
+ * - failure: 0 (the base layer's, which is never popped) (out of bounds)
+ */
+uint8_t main_layers_peek_id(uint8_t offset) {
+	if (offset <= layers_head)
+		return layers[layers_head - offset].id;
+
+	return 0;  // default, or error
+}
+
 /*
  * push()
  *
@@ -223,18 +550,30 @@ uint8_t main_layers_peek_sticky(uint8_t offset) {
  *
  * Returns
  * - success: the id assigned to the newly added element
- * - failure: 0 (the stack was already full)
+ * - failure: 0 (the stack was already full, or the layout doesn't define
+ *   'layer')
+ *
+ * Note
+ * - This is the only place layer numbers are checked against the layout, so
+ *   that the lookups done for every key event can stay a plain index.
  */
 uint8_t main_layers_push(uint8_t layer, uint8_t sticky) {
+	if (layer >= kb_keymap_layers_get())
+		return 0;  // error
+
 	// look for an available id
 	for (uint8_t id=1; id<MAX_ACTIVE_LAYERS; id++) {
 		// if one is found
-		if (layers_ids_in_use[id] == false) {
-			layers_ids_in_use[id] = true;
+		if ( !(layers_ids_in_use & layers_id_bit(id)) ) {
+			layers_ids_in_use |= layers_id_bit(id);
 			layers_head++;
 			layers[layers_head].layer = layer;
 			layers[layers_head].id = id;
 			layers[layers_head].sticky = sticky;
+			main_layers_changed = true;
+			#if KB_KEYMAPS > 1
+				layers[layers_head].layout_layer = kb_keymap_layer_get(layer);
+			#endif
 			return id;
 		}
 	}
@@ -257,13 +596,20 @@ void main_layers_pop_id(uint8_t id) {
 			for (; element<layers_head; element++) {
 				layers[element].layer = layers[element+1].layer;
 				layers[element].id = layers[element+1].id;
+				layers[element].sticky = layers[element+1].sticky;
+				#if KB_KEYMAPS > 1
+					layers[element].layout_layer =
+						layers[element+1].layout_layer;
+				#endif
 			}
 			// reinitialize the topmost (now unused) slot
 			layers[layers_head].layer = 0;
 			layers[layers_head].id = 0;
+			layers[layers_head].sticky = eStickyNone;
 			// record keeping
-			layers_ids_in_use[id] = false;
+			layers_ids_in_use &= ~layers_id_bit(id);
 			layers_head--;
+			main_layers_changed = true;
 		}
 }
 
@@ -289,6 +635,48 @@ uint8_t main_layers_get_offset_id(uint8_t id) {
 
 }
 
+/* ----------------------------------------------------------------------------
+ * Keymap Functions
+ * ----------------------------------------------------------------------------
+ * When several keymaps are linked in (see "default--matrix-control.h"), one
+ * of them is active at a time.  Which one is remembered in the EEPROM, so it
+ * survives being unplugged.
+ * ------------------------------------------------------------------------- */
+
+/*
+ * keymap_select()
+ *
+ * Arguments
+ * - 'keymap': the number of the keymap to make active (an out of range
+ *   number, e.g. from an erased EEPROM, selects keymap 0)
+ *
+ * Note
+ * - All pushed layers are popped: their numbers belong to the old keymap.
+ *   The key functions that remember the ids of the layers they pushed
+ *   forget them.  Keys still held keep the layer they were pressed on, so
+ *   they release normally.
+ * - Does nothing if only one keymap is linked in.
+ */
+void main_keymap_select(uint8_t keymap) {
+#if KB_KEYMAPS > 1
+	if (keymap >= KB_KEYMAPS)
+		keymap = 0;
+
+	main_keymap = keymap;
+	main_keymap_layers = _kb_keymap_layers[keymap];
+	main_keymap_layer_count = pgm_read_byte(&_kb_keymap_layer_counts[keymap]);
+
+	while (layers_head)
+		main_layers_pop_id(layers[layers_head].id);
+	layers[0].layout_layer = kb_keymap_layer_get(0);
+	_kbfun_layer_reset();
+	_kbfun_numpad_reset();
+	_kbfun_macro_layer_reset();
+
+	eeprom_update_byte(&main_keymap_eeprom, keymap);
+#endif
+}
+
 /* ----------------------------------------------------------------------------
  * ------------------------------------------------------------------------- */
 
@@ -12,6 +12,7 @@
 
 	#include <stdbool.h>
 	#include <stdint.h>
+	#include "./keyboard/layout.h"
 	#include "./keyboard/matrix.h"
 
 	// --------------------------------------------------------------------
@@ -27,7 +28,42 @@
 	extern bool (*main_kb_is_pressed)[KB_ROWS][KB_COLUMNS];
 	extern bool (*main_kb_was_pressed)[KB_ROWS][KB_COLUMNS];
 
-	extern uint8_t main_layers_pressed[KB_ROWS][KB_COLUMNS];
+	/*
+	 * the layer each key was pressed on, and whether it was pressed through
+	 * a transparent key (so it can be released using the function from
+	 * that layer, and in the same way)
+	 *
+	 * - Packed: one byte per key (the layer in the low 5 bits, the
+	 *   transparency flag in the high bit), or one nibble per key if the
+	 *   layout has no more than 8 layers (`KB_LAYERS`).  Use the accessors
+	 *   below.
+	 * - Layer numbers can't be truncated by the packing: pushes are checked
+	 *   against the number of layers the layout defines (see
+	 *   `main_layers_push()`), which is checked against `KB_LAYERS` at
+	 *   compile time (see `KB_LAYOUT_LAYERS_DEFINE()`).
+	 */
+	#if KB_LAYERS <= 8
+		#define  MAIN_KEYS_PER_PRESSED_BYTE  2
+		#define  MAIN_PRESSED_LAYER_MASK     0x07
+		#define  MAIN_PRESSED_TRANS_BIT      0x08
+	#else
+		#define  MAIN_KEYS_PER_PRESSED_BYTE  1
+		#define  MAIN_PRESSED_LAYER_MASK     0x1F
+		#define  MAIN_PRESSED_TRANS_BIT      0x80
+	#endif
+
+	extern uint8_t main_layers_pressed[ ( KB_ROWS*KB_COLUMNS
+	                                      + MAIN_KEYS_PER_PRESSED_BYTE-1 )
+	                                    / MAIN_KEYS_PER_PRESSED_BYTE ];
+
+	extern bool main_layers_changed;  // set whenever a layer is pushed or
+	                                  //   popped; cleared by `main()`
+
+	// startup times, in milliseconds since the timer started (just after
+	// reset): when the host configured the keyboard, and when the first key
+	// press was sent (0 until then)
+	extern uint16_t main_boot_usb_ms;
+	extern uint16_t main_boot_first_key_ms;
 
 	extern uint8_t main_loop_row;
 	extern uint8_t main_loop_col;
@@ -43,14 +79,68 @@
 
 	// --------------------------------------------------------------------
 
-	void main_exec_key (void);
+	// returns the byte holding the key's state, and sets '*shift' to where
+	// in that byte it is
+	static inline uint8_t * _main_pressed_byte( uint8_t row, uint8_t col,
+	                                            uint8_t * shift ) {
+	#if MAIN_KEYS_PER_PRESSED_BYTE == 2
+		uint8_t key = row*KB_COLUMNS + col;
+		*shift = (key & 1) ? 4 : 0;
+		return &main_layers_pressed[key >> 1];
+	#else
+		*shift = 0;
+		return &main_layers_pressed[row*KB_COLUMNS + col];
+	#endif
+	}
+
+	static inline uint8_t main_layers_pressed_get(uint8_t row, uint8_t col) {
+		uint8_t shift;
+		uint8_t * byte = _main_pressed_byte(row, col, &shift);
+		return (*byte >> shift) & MAIN_PRESSED_LAYER_MASK;
+	}
+
+	static inline void main_layers_pressed_set( uint8_t row, uint8_t col,
+	                                            uint8_t layer ) {
+		uint8_t shift;
+		uint8_t * byte = _main_pressed_byte(row, col, &shift);
+		*byte = ( (*byte & ~(MAIN_PRESSED_LAYER_MASK << shift))
+		          | ((layer & MAIN_PRESSED_LAYER_MASK) << shift) );
+	}
+
+	static inline bool main_kb_was_transparent_get(uint8_t row, uint8_t col) {
+		uint8_t shift;
+		uint8_t * byte = _main_pressed_byte(row, col, &shift);
+		return (*byte >> shift) & MAIN_PRESSED_TRANS_BIT;
+	}
+
+	static inline void main_kb_was_transparent_set( uint8_t row, uint8_t col,
+	                                                bool transparent ) {
+		uint8_t shift;
+		uint8_t * byte = _main_pressed_byte(row, col, &shift);
+		if (transparent)
+			*byte |= (MAIN_PRESSED_TRANS_BIT << shift);
+		else
+			*byte &= ~(MAIN_PRESSED_TRANS_BIT << shift);
+	}
+
+	// --------------------------------------------------------------------
+
+	bool main_key_event (uint8_t row, uint8_t col, bool is_pressed);
+	void main_key_exec  (uint8_t row, uint8_t col, bool is_pressed);
+	void main_exec_key  (void);
 
 	uint8_t main_layers_peek          (uint8_t offset);
+	uint8_t main_layers_peek_layout   (uint8_t offset);
 	uint8_t main_layers_peek_sticky   (uint8_t offset);
+	uint8_t main_layers_peek_id       (uint8_t offset);
 	uint8_t main_layers_push          (uint8_t layer, uint8_t sticky);
 	void    main_layers_pop_id        (uint8_t id);
 	uint8_t main_layers_get_offset_id (uint8_t id);
 
+	extern uint8_t main_keymap;
+
+	void    main_keymap_select        (uint8_t keymap);
+
 
 #endif
 
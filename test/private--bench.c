@@ -0,0 +1,158 @@
+/* ----------------------------------------------------------------------------
+ * host tests : key functions : private : benchmark
+ *
+ * Times `_kbfun_press_release()` and `_kbfun_is_pressed()` (see
+ * "src/lib/key-functions/private.c") over every usage, against the
+ * eight-way `switch` they used to map modifiers with.  Host timings only
+ * show which way is cheaper; the AVR's will differ.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "../src/lib-other/pjrc/usb_keyboard/usb_keyboard.h"
+#include "../src/lib/usb/usage-page/keyboard.h"
+#include "../src/lib/key-functions/private.h"
+
+// ----------------------------------------------------------------------------
+
+#define  ROUNDS  20000  // over all 256 usages
+
+static volatile uint8_t _sink;
+
+// ----------------------------------------------------------------------------
+
+/*
+ * The modifier mapping, as it was (a `switch` per call)
+ */
+__attribute__((noinline))
+static void _switch_press_release(bool press, uint8_t keycode) {
+	if (keycode == 0)
+		return;
+
+	switch (keycode) {
+		case KEY_LeftControl:  (press)
+				       ? (keyboard_modifier_keys |=  (1<<0))
+				       : (keyboard_modifier_keys &= ~(1<<0));
+				       return;
+		case KEY_LeftShift:    (press)
+				       ? (keyboard_modifier_keys |=  (1<<1))
+				       : (keyboard_modifier_keys &= ~(1<<1));
+				       return;
+		case KEY_LeftAlt:      (press)
+				       ? (keyboard_modifier_keys |=  (1<<2))
+				       : (keyboard_modifier_keys &= ~(1<<2));
+				       return;
+		case KEY_LeftGUI:      (press)
+				       ? (keyboard_modifier_keys |=  (1<<3))
+				       : (keyboard_modifier_keys &= ~(1<<3));
+				       return;
+		case KEY_RightControl: (press)
+				       ? (keyboard_modifier_keys |=  (1<<4))
+				       : (keyboard_modifier_keys &= ~(1<<4));
+				       return;
+		case KEY_RightShift:   (press)
+				       ? (keyboard_modifier_keys |=  (1<<5))
+				       : (keyboard_modifier_keys &= ~(1<<5));
+				       return;
+		case KEY_RightAlt:     (press)
+				       ? (keyboard_modifier_keys |=  (1<<6))
+				       : (keyboard_modifier_keys &= ~(1<<6));
+				       return;
+		case KEY_RightGUI:     (press)
+				       ? (keyboard_modifier_keys |=  (1<<7))
+				       : (keyboard_modifier_keys &= ~(1<<7));
+				       return;
+	}
+
+	if (press && _kbfun_one_shot_mods)
+		_kbfun_one_shot_use();
+
+	for (uint8_t i=0; i<6; i++) {
+		if (press) {
+			if (keyboard_keys[i] == 0) {
+				keyboard_keys[i] = keycode;
+				return;
+			}
+		} else {
+			if (keyboard_keys[i] == keycode) {
+				keyboard_keys[i] = 0;
+				return;
+			}
+		}
+	}
+}
+
+/*
+ * (as it was, cases falling through and all)
+ */
+__attribute__((noinline))
+static bool _switch_is_pressed(uint8_t keycode) {
+	switch (keycode) {
+		case KEY_LeftControl:  if (keyboard_modifier_keys & (1<<0))
+					       return true;
+		case KEY_LeftShift:    if (keyboard_modifier_keys & (1<<1))
+					       return true;
+		case KEY_LeftAlt:      if (keyboard_modifier_keys & (1<<2))
+					       return true;
+		case KEY_LeftGUI:      if (keyboard_modifier_keys & (1<<3))
+					       return true;
+		case KEY_RightControl: if (keyboard_modifier_keys & (1<<4))
+					       return true;
+		case KEY_RightShift:   if (keyboard_modifier_keys & (1<<5))
+					       return true;
+		case KEY_RightAlt:     if (keyboard_modifier_keys & (1<<6))
+					       return true;
+		case KEY_RightGUI:     if (keyboard_modifier_keys & (1<<7))
+					       return true;
+	}
+
+	for (uint8_t i=0; i<6; i++)
+		if (keyboard_keys[i] == keycode)
+			return true;
+
+	return false;
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Press, look up, and release every usage `ROUNDS` times
+ *
+ * Returns
+ * - the time taken per usage, in nanoseconds
+ */
+static double _time( void (*press_release)(bool, uint8_t),
+                     bool (*is_pressed)(uint8_t) ) {
+	struct timespec start, end;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (unsigned round=0; round<ROUNDS; round++)
+		for (unsigned u=0; u<=0xFF; u++) {
+			(*press_release)(true, u);
+			_sink = (*is_pressed)(u);
+			(*press_release)(false, u);
+		}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return ( (end.tv_sec - start.tv_sec) * 1e9
+	         + (end.tv_nsec - start.tv_nsec) ) / ((double)ROUNDS * 256);
+}
+
+// ----------------------------------------------------------------------------
+
+int main(void) {
+	double was = _time(&_switch_press_release, &_switch_is_pressed);
+	double is  = _time(&_kbfun_press_release, &_kbfun_is_pressed);
+
+	printf("private--bench: switch %.2f ns/usage, subtract and shift %.2f "
+	       "ns/usage\n", was, is);
+	return 0;
+}
+
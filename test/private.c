@@ -0,0 +1,130 @@
+/* ----------------------------------------------------------------------------
+ * host tests : key functions : private
+ *
+ * Checks `_kbfun_press_release()` and `_kbfun_is_pressed()` (see
+ * "src/lib/key-functions/private.c") for every usage, 0x00 through 0xFF:
+ * each modifier (0xE0 through 0xE7) must set and clear only its own bit of
+ * `keyboard_modifier_keys`, and every other usage (but 0, which does
+ * nothing) must take one slot of `keyboard_keys`.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "../src/lib-other/pjrc/usb_keyboard/usb_keyboard.h"
+#include "../src/lib/usb/usage-page/keyboard.h"
+#include "../src/lib/key-functions/private.h"
+
+// ----------------------------------------------------------------------------
+
+static unsigned _checks;
+static unsigned _failed;
+
+#define  check(condition, usage)  _check((condition), #condition, (usage))
+
+static void _check(bool condition, const char * text, unsigned usage) {
+	_checks++;
+	if (condition)
+		return;
+	_failed++;
+	printf("failed: usage 0x%02X: %s\n", usage, text);
+}
+
+static void _clear(void) {
+	keyboard_modifier_keys = 0;
+	memset(keyboard_keys, 0, sizeof(keyboard_keys));
+}
+
+/*
+ * Whether the report holds exactly the given modifiers and key (0 for none)
+ */
+static bool _report_is(uint8_t modifiers, uint8_t keycode) {
+	if (keyboard_modifier_keys != modifiers || keyboard_keys[0] != keycode)
+		return false;
+	for (uint8_t i=1; i<6; i++)
+		if (keyboard_keys[i])
+			return false;
+	return true;
+}
+
+static bool _is_modifier(unsigned usage) {
+	return usage >= KEY_LeftControl && usage <= KEY_RightGUI;
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Press, look up, and release each usage on its own
+ */
+static void _each_alone(void) {
+	for (unsigned u=0; u<=0xFF; u++) {
+		uint8_t modifiers = _is_modifier(u) ? 1 << (u - KEY_LeftControl) : 0;
+		uint8_t keycode = (_is_modifier(u) || u == 0) ? 0 : u;
+
+		_clear();
+		_kbfun_press_release(true, u);
+		check( _report_is(modifiers, keycode), u );
+
+		// (not 0: an empty slot in `keyboard_keys` reads as usage 0)
+		for (unsigned v=1; v<=0xFF; v++)
+			check( _kbfun_is_pressed(v) == (v == u), v );
+
+		_kbfun_press_release(false, u);
+		check( _report_is(0, 0), u );
+	}
+}
+
+/*
+ * With every modifier held, release each in turn
+ */
+static void _modifiers_together(void) {
+	_clear();
+	for (unsigned u=KEY_LeftControl; u<=KEY_RightGUI; u++)
+		_kbfun_press_release(true, u);
+	check( _report_is(0xFF, 0), KEY_RightGUI );
+
+	for (unsigned u=KEY_LeftControl; u<=KEY_RightGUI; u++) {
+		uint8_t left = 0xFF << (u - KEY_LeftControl + 1);
+
+		_kbfun_press_release(false, u);
+		check( _report_is(left, 0), u );
+		check( !_kbfun_is_pressed(u), u );
+		for (unsigned v=u+1; v<=KEY_RightGUI; v++)
+			check( _kbfun_is_pressed(v), v );
+	}
+}
+
+/*
+ * Six keys fit in the report; a seventh is dropped, and the slot freed by a
+ * release is reused
+ */
+static void _six_keys(void) {
+	_clear();
+	for (unsigned u=KEY_a_A; u<KEY_a_A+7; u++)
+		_kbfun_press_release(true, u);
+	check( !_kbfun_is_pressed(KEY_a_A+6), KEY_a_A+6 );
+
+	_kbfun_press_release(false, KEY_a_A+2);
+	check( keyboard_keys[2] == 0, KEY_a_A+2 );
+	_kbfun_press_release(true, KEY_a_A+6);
+	check( keyboard_keys[2] == KEY_a_A+6, KEY_a_A+6 );
+	check( keyboard_modifier_keys == 0, KEY_a_A+6 );
+}
+
+// ----------------------------------------------------------------------------
+
+int main(void) {
+	_each_alone();
+	_modifiers_together();
+	_six_keys();
+
+	printf("private: %u checks, %u failed\n", _checks, _failed);
+	return _failed ? 1 : 0;
+}
+
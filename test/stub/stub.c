@@ -0,0 +1,23 @@
+/* ----------------------------------------------------------------------------
+ * host tests : stubs
+ *
+ * What "src/lib/key-functions/private.c" uses from the rest of the firmware.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2012 Ben Blazak <benblazak.dev@gmail.com>
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdint.h>
+
+// (see "src/lib-other/pjrc/usb_keyboard/usb_keyboard.c")
+uint8_t  keyboard_modifier_keys;
+uint8_t  keyboard_keys[6];
+uint16_t consumer_key;
+
+// (see "src/lib/key-functions/one-shot.c"; no one-shot modifiers are held)
+uint8_t _kbfun_one_shot_mods;
+
+void _kbfun_one_shot_use(void) {}
+